@@ -0,0 +1,640 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "s21_cholesky_solver.h"
+#include "s21_lu_solver.h"
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_arena.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_expr.h"
+#include "s21_matrix_io.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_strassen.h"
+#include "s21_matrix_text.h"
+#include "s21_refined_solver.h"
+#include "s21_sparse_matrix.h"
+
+// Every heap allocation of the process is counted so that benchmarks can
+// report the bytes allocated per call of the measured operation
+
+namespace {
+
+std::atomic<long long> allocatedBytes{0};
+
+void* countedAlloc(std::size_t size, std::size_t alignment) {
+  allocatedBytes.fetch_add(static_cast<long long>(size),
+                           std::memory_order_relaxed);
+  void* pointer = nullptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    pointer = std::malloc(size ? size : 1);
+  } else if (posix_memalign(&pointer, alignment, size ? size : 1) != 0) {
+    pointer = nullptr;
+  }
+  if (!pointer) throw std::bad_alloc();
+  return pointer;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size, 0); }
+void* operator new[](std::size_t size) { return countedAlloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+S21Matrix randomMatrix(int rows, int cols) {
+  S21Matrix matrix(rows, cols);
+  matrix.setValue();
+  return matrix;
+}
+
+// Random matrix made safely invertible by a dominant diagonal
+S21Matrix regularMatrix(int n) {
+  S21Matrix matrix = randomMatrix(n, n);
+  for (int i = 0; i < n; i++) matrix(i, i) += n;
+  return matrix;
+}
+
+// Symmetric positive definite, X^T * X + n * I like a Gram matrix
+S21Matrix spdMatrix(int n) {
+  S21Matrix x = randomMatrix(n, n);
+  S21Matrix matrix = x.Transpose() * x;
+  for (int i = 0; i < n; i++) matrix(i, i) += n;
+  return matrix;
+}
+
+// Runs body once per iteration and attaches the counters: FLOP/s from the
+// flop count of one call, bytes allocated and bytes moved per call
+template <class Body>
+void measure(benchmark::State& state, double flops, double bytes, Body body) {
+  long long before = allocatedBytes.load();
+  for (auto _ : state) body();
+  long long allocated = allocatedBytes.load() - before;
+
+  state.counters["FLOP/s"] = benchmark::Counter(
+      flops, benchmark::Counter::kIsIterationInvariantRate,
+      benchmark::Counter::kIs1000);
+  state.counters["alloc_bytes"] =
+      benchmark::Counter(static_cast<double>(allocated),
+                         benchmark::Counter::kAvgIterations,
+                         benchmark::Counter::kIs1024);
+  state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+}
+
+void sizes(benchmark::internal::Benchmark* bench) {
+  bench->RangeMultiplier(2)->Range(2, 4096)->Unit(benchmark::kMicrosecond);
+}
+
+constexpr double kDouble = sizeof(double);
+
+void BM_Constructor(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  measure(state, 0, kDouble * n * n, [n] {
+    S21Matrix matrix(n, n);
+    benchmark::DoNotOptimize(matrix.getData());
+  });
+}
+BENCHMARK(BM_Constructor)->Apply(sizes);
+
+void BM_CopyConstructor(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix source = randomMatrix(n, n);
+  measure(state, 0, 2 * kDouble * n * n, [&source] {
+    S21Matrix copy(source);
+    benchmark::DoNotOptimize(copy.getData());
+  });
+}
+BENCHMARK(BM_CopyConstructor)->Apply(sizes);
+
+void BM_MoveConstructor(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix source = randomMatrix(n, n);
+  measure(state, 0, 0, [&source] {
+    S21Matrix moved(std::move(source));
+    benchmark::DoNotOptimize(moved.getData());
+    source = std::move(moved);
+  });
+}
+BENCHMARK(BM_MoveConstructor)->Apply(sizes);
+
+void BM_CopyAssignment(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix source = randomMatrix(n, n);
+  S21Matrix target(n, n);
+  measure(state, 0, 2 * kDouble * n * n, [&] {
+    target = source;
+    benchmark::DoNotOptimize(target.getData());
+  });
+}
+BENCHMARK(BM_CopyAssignment)->Apply(sizes);
+
+void BM_EqMatrix(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b(a);
+  measure(state, n * n, 2 * kDouble * n * n,
+          [&] { benchmark::DoNotOptimize(a.EqMatrix(b)); });
+}
+BENCHMARK(BM_EqMatrix)->Apply(sizes);
+
+void BM_SumMatrix(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b = randomMatrix(n, n);
+  measure(state, n * n, 3 * kDouble * n * n, [&] {
+    a.SumMatrix(b);
+    benchmark::ClobberMemory();
+  });
+}
+BENCHMARK(BM_SumMatrix)->Apply(sizes);
+
+void BM_SubMatrix(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b = randomMatrix(n, n);
+  measure(state, n * n, 3 * kDouble * n * n, [&] {
+    a.SubMatrix(b);
+    benchmark::ClobberMemory();
+  });
+}
+BENCHMARK(BM_SubMatrix)->Apply(sizes);
+
+void BM_MulNumber(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  measure(state, n * n, 2 * kDouble * n * n, [&] {
+    a.MulNumber(1.0000001);
+    benchmark::ClobberMemory();
+  });
+}
+BENCHMARK(BM_MulNumber)->Apply(sizes);
+
+// float counterparts of the element-wise operations: half the bytes per
+// element, twice the elements per vector register
+void BM_SumMatrixFloat(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21FloatMatrix a(randomMatrix(n, n));
+  S21FloatMatrix b(randomMatrix(n, n));
+  measure(state, n * n, 3.0 * sizeof(float) * n * n, [&] {
+    a.SumMatrix(b);
+    benchmark::ClobberMemory();
+  });
+}
+BENCHMARK(BM_SumMatrixFloat)->Apply(sizes);
+
+void BM_MulNumberFloat(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21FloatMatrix a(randomMatrix(n, n));
+  measure(state, n * n, 2.0 * sizeof(float) * n * n, [&] {
+    a.MulNumber(1.0000001f);
+    benchmark::ClobberMemory();
+  });
+}
+BENCHMARK(BM_MulNumberFloat)->Apply(sizes);
+
+void BM_OperatorChain(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b = randomMatrix(n, n);
+  S21Matrix c = randomMatrix(n, n);
+  measure(state, 3.0 * n * n, 6 * kDouble * n * n, [&] {
+    S21Matrix result = (a + b) * 2.0 - c;
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_OperatorChain)->Apply(sizes);
+
+void BM_OperatorChainArena(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b = randomMatrix(n, n);
+  S21Matrix c = randomMatrix(n, n);
+  s21::ScopedArena arena;
+  measure(state, 3.0 * n * n, 6 * kDouble * n * n, [&] {
+    S21Matrix result = (a + b) * 2.0 - c;
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_OperatorChainArena)->Apply(sizes);
+
+void BM_LazyChain(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b = randomMatrix(n, n);
+  S21Matrix c = randomMatrix(n, n);
+  S21Matrix result(n, n);
+  measure(state, 3.0 * n * n, 4 * kDouble * n * n, [&] {
+    result = (s21::Lazy(a) + b) * 2.0 - c;
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_LazyChain)->Apply(sizes);
+
+void BM_MulMatrix(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b = randomMatrix(n, n);
+  measure(state, 2.0 * n * n * n, 3 * kDouble * n * n, [&] {
+    S21Matrix result = a * b;
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_MulMatrix)->Apply(sizes);
+
+// Same products through Strassen(); FLOP/s counts the classical 2n^3, so
+// the rate is directly comparable with BM_MulMatrix
+void BM_MulStrassen(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  int crossover = static_cast<int>(state.range(1));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b = randomMatrix(n, n);
+  S21Matrix c(n, n);
+  measure(state, 2.0 * n * n * n, 3 * kDouble * n * n, [&] {
+    s21::Strassen(n, n, n, a.getData(), a.getStride(), b.getData(),
+                  b.getStride(), c.getData(), c.getStride(), crossover);
+    benchmark::DoNotOptimize(c.getData());
+  });
+}
+BENCHMARK(BM_MulStrassen)
+    ->ArgsProduct({{512, 1024, 2048, 4096}, {256, 512, 1024}})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_MulTransposeView(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  S21Matrix b = randomMatrix(n, n);
+  measure(state, 2.0 * n * n * n, 3 * kDouble * n * n, [&] {
+    S21Matrix result = a.TransposeView() * b;
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_MulTransposeView)->Apply(sizes);
+
+void BM_Transpose(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = randomMatrix(n, n);
+  measure(state, 0, 2 * kDouble * n * n, [&] {
+    S21Matrix result = a.Transpose();
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_Transpose)->Apply(sizes);
+
+void BM_Determinant(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = regularMatrix(n);
+  // the write drops the cached factorization, every iteration factors
+  measure(state, 2.0 / 3.0 * n * n * n, kDouble * n * n, [&] {
+    a(0, 0) += 0;
+    benchmark::DoNotOptimize(a.Determinant());
+  });
+}
+BENCHMARK(BM_Determinant)->Apply(sizes);
+
+// Repeated queries on an unchanged matrix, answered from the cache
+void BM_DeterminantCached(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = regularMatrix(n);
+  a.Determinant();
+  measure(state, 0, 0, [&] { benchmark::DoNotOptimize(a.Determinant()); });
+}
+BENCHMARK(BM_DeterminantCached)->Apply(sizes);
+
+void BM_CalcComplements(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = regularMatrix(n);
+  measure(state, 2.0 * n * n * n, 2 * kDouble * n * n, [&] {
+    a(0, 0) += 0;
+    S21Matrix result = a.CalcComplements();
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_CalcComplements)->Apply(sizes);
+
+void BM_InverseMatrix(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = regularMatrix(n);
+  measure(state, 2.0 * n * n * n, 2 * kDouble * n * n, [&] {
+    a(0, 0) += 0;
+    S21Matrix result = a.InverseMatrix();
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_InverseMatrix)->Apply(sizes);
+
+void BM_InverseMatrixCached(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = regularMatrix(n);
+  a.InverseMatrix();
+  measure(state, 0, 2 * kDouble * n * n, [&] {
+    S21Matrix result = a.InverseMatrix();
+    benchmark::DoNotOptimize(result.getData());
+  });
+}
+BENCHMARK(BM_InverseMatrixCached)->Apply(sizes);
+
+// The same SPD input factored by Cholesky and by LU
+void BM_CholeskyFactor(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = spdMatrix(n);
+  measure(state, n * n * n / 3.0, kDouble * n * n, [&] {
+    S21CholeskySolver cholesky(a);
+    benchmark::DoNotOptimize(cholesky.getFactor().getData());
+  });
+}
+BENCHMARK(BM_CholeskyFactor)->Apply(sizes);
+
+void BM_LuFactorSpd(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = spdMatrix(n);
+  measure(state, 2.0 / 3.0 * n * n * n, kDouble * n * n, [&] {
+    S21LuSolver lu(a);
+    benchmark::DoNotOptimize(&lu);
+  });
+}
+BENCHMARK(BM_LuFactorSpd)->Apply(sizes);
+
+// InverseMatrix() of an SPD matrix with detection on (Cholesky) and off
+// (LU)
+void inverseSpd(benchmark::State& state, bool detection) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = spdMatrix(n);
+  s21::SetSpdDetection(detection);
+  measure(state, (detection ? 1.0 : 2.0) * n * n * n, 2 * kDouble * n * n,
+          [&] {
+            a(0, 0) += 0;
+            S21Matrix result = a.InverseMatrix();
+            benchmark::DoNotOptimize(result.getData());
+          });
+  s21::SetSpdDetection(true);
+}
+
+void BM_InverseSpd(benchmark::State& state) { inverseSpd(state, true); }
+BENCHMARK(BM_InverseSpd)->Apply(sizes);
+
+void BM_InverseSpdLu(benchmark::State& state) { inverseSpd(state, false); }
+BENCHMARK(BM_InverseSpdLu)->Apply(sizes);
+
+// One factorization reused for a right-hand side per iteration against
+// solving through the inverse
+void BM_LuSolveVector(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21LuSolver lu(regularMatrix(n));
+  std::vector<double> b(n, 1.0);
+  measure(state, 2.0 * n * n, kDouble * n * n, [&] {
+    std::vector<double> x = lu.Solve(b);
+    benchmark::DoNotOptimize(x.data());
+  });
+}
+BENCHMARK(BM_LuSolveVector)->Apply(sizes);
+
+// Factorization plus one solve, in double and with float factors refined
+// to double accuracy
+void BM_SolveDouble(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = regularMatrix(n);
+  std::vector<double> b(n, 1.0);
+  measure(state, 2.0 / 3.0 * n * n * n, kDouble * n * n, [&] {
+    std::vector<double> x = S21LuSolver(a).Solve(b);
+    benchmark::DoNotOptimize(x.data());
+  });
+}
+BENCHMARK(BM_SolveDouble)
+    ->RangeMultiplier(2)
+    ->Range(256, 2048)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_SolveRefined(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix a = regularMatrix(n);
+  std::vector<double> b(n, 1.0);
+  measure(state, 2.0 / 3.0 * n * n * n, kDouble * n * n, [&] {
+    std::vector<double> x = S21RefinedSolver(a).Solve(b);
+    benchmark::DoNotOptimize(x.data());
+  });
+}
+BENCHMARK(BM_SolveRefined)
+    ->RangeMultiplier(2)
+    ->Range(256, 2048)
+    ->Unit(benchmark::kMillisecond);
+
+// Small matrices one object at a time against the same work batched,
+// kBatchCount matrices of size range(0) per iteration
+constexpr int kBatchCount = 4096;
+
+void smallSizes(benchmark::internal::Benchmark* bench) {
+  bench->DenseRange(3, 8)->Unit(benchmark::kMicrosecond);
+}
+
+void BM_SingleDeterminant(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  std::vector<S21Matrix> matrices;
+  for (int m = 0; m < kBatchCount; m++) matrices.push_back(regularMatrix(n));
+  measure(state, kBatchCount * 2.0 / 3.0 * n * n * n,
+          kDouble * kBatchCount * n * n, [&matrices] {
+            for (S21Matrix& matrix : matrices) {
+              benchmark::DoNotOptimize(matrix.Determinant());
+            }
+          });
+}
+BENCHMARK(BM_SingleDeterminant)->Apply(smallSizes);
+
+void BM_BatchDeterminant(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21MatrixBatch batch(kBatchCount, n, n);
+  for (int m = 0; m < kBatchCount; m++) batch.Set(m, regularMatrix(n));
+  measure(state, kBatchCount * 2.0 / 3.0 * n * n * n,
+          kDouble * kBatchCount * n * n, [&batch] {
+            std::vector<double> det = batch.Determinant();
+            benchmark::DoNotOptimize(det.data());
+          });
+}
+BENCHMARK(BM_BatchDeterminant)->Apply(smallSizes);
+
+void BM_SingleInverse(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  std::vector<S21Matrix> matrices;
+  for (int m = 0; m < kBatchCount; m++) matrices.push_back(regularMatrix(n));
+  measure(state, kBatchCount * 2.0 * n * n * n,
+          2 * kDouble * kBatchCount * n * n, [&matrices] {
+            for (S21Matrix& matrix : matrices) {
+              S21Matrix inverse = matrix.InverseMatrix();
+              benchmark::DoNotOptimize(inverse.getData());
+            }
+          });
+}
+BENCHMARK(BM_SingleInverse)->Apply(smallSizes);
+
+void BM_BatchInverse(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21MatrixBatch batch(kBatchCount, n, n);
+  for (int m = 0; m < kBatchCount; m++) batch.Set(m, regularMatrix(n));
+  measure(state, kBatchCount * 2.0 * n * n * n,
+          2 * kDouble * kBatchCount * n * n, [&batch] {
+            S21MatrixBatch inverse = batch.InverseMatrix();
+            benchmark::DoNotOptimize(inverse.getData());
+          });
+}
+BENCHMARK(BM_BatchInverse)->Apply(smallSizes);
+
+void BM_SingleMul(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  std::vector<S21Matrix> matrices;
+  for (int m = 0; m < kBatchCount; m++) matrices.push_back(randomMatrix(n, n));
+  measure(state, kBatchCount * 2.0 * n * n * n,
+          3 * kDouble * kBatchCount * n * n, [&matrices] {
+            for (S21Matrix& matrix : matrices) {
+              S21Matrix product = matrix * matrix;
+              benchmark::DoNotOptimize(product.getData());
+            }
+          });
+}
+BENCHMARK(BM_SingleMul)->Apply(smallSizes);
+
+void BM_BatchMul(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21MatrixBatch batch(kBatchCount, n, n);
+  for (int m = 0; m < kBatchCount; m++) batch.Set(m, randomMatrix(n, n));
+  measure(state, kBatchCount * 2.0 * n * n * n,
+          3 * kDouble * kBatchCount * n * n, [&batch] {
+            S21MatrixBatch product = batch * batch;
+            benchmark::DoNotOptimize(product.getData());
+          });
+}
+BENCHMARK(BM_BatchMul)->Apply(smallSizes);
+
+void BM_Load(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  const char* path = "bench_matrix.bin";
+  s21::Save(randomMatrix(n, n), path);
+  measure(state, 0, kDouble * n * n, [path] {
+    S21Matrix matrix = s21::Load(path);
+    benchmark::DoNotOptimize(matrix.getData());
+  });
+  std::remove(path);
+}
+BENCHMARK(BM_Load)->Apply(sizes);
+
+// Opening only, pages are read when first touched
+void BM_Map(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  const char* path = "bench_matrix.bin";
+  s21::Save(randomMatrix(n, n), path);
+  measure(state, 0, 0, [path] {
+    s21::MappedMatrix matrix(path);
+    benchmark::DoNotOptimize(matrix.View().getData());
+  });
+  std::remove(path);
+}
+BENCHMARK(BM_Map)->Apply(sizes);
+
+void BM_ReadText(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  std::ostringstream out;
+  s21::WriteText(out, randomMatrix(n, n));
+  const std::string text = out.str();
+  measure(state, 0, static_cast<double>(text.size()), [&text] {
+    std::istringstream in(text);
+    S21Matrix matrix = s21::ReadText(in);
+    benchmark::DoNotOptimize(matrix.getData());
+  });
+}
+BENCHMARK(BM_ReadText)->Apply(sizes);
+
+void BM_WriteText(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix matrix = randomMatrix(n, n);
+  std::ostringstream probe;
+  s21::WriteText(probe, matrix);
+  double bytes = static_cast<double>(probe.str().size());
+  measure(state, 0, bytes, [&matrix] {
+    std::ostringstream out;
+    s21::WriteText(out, matrix);
+    benchmark::DoNotOptimize(out.str().data());
+  });
+}
+BENCHMARK(BM_WriteText)->Apply(sizes);
+
+// Random n x n sparse matrix with about one percent non-zeros per row
+S21SparseMatrix sparseMatrix(int n) {
+  std::vector<S21SparseMatrix::Triplet> triplets;
+  int perRow = n / 100 + 1;
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < perRow; k++) {
+      triplets.push_back({i, std::rand() % n, std::rand() % 1000 / 100.0});
+    }
+  }
+  return S21SparseMatrix(n, n, triplets);
+}
+
+void BM_DenseMulVector(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21Matrix matrix = sparseMatrix(n).ToDense();
+  S21Matrix x = randomMatrix(n, 1);
+  measure(state, 2.0 * n * n, kDouble * n * n, [&] {
+    S21Matrix y = matrix * x;
+    benchmark::DoNotOptimize(y.getData());
+  });
+}
+BENCHMARK(BM_DenseMulVector)->Apply(sizes);
+
+void BM_SparseMulVector(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21SparseMatrix matrix = sparseMatrix(n);
+  std::vector<double> x(n, 1.5);
+  double nonZeros = static_cast<double>(matrix.getNonZeros());
+  measure(state, 2 * nonZeros, 12 * nonZeros, [&] {
+    std::vector<double> y = matrix.MulVector(x);
+    benchmark::DoNotOptimize(y.data());
+  });
+}
+BENCHMARK(BM_SparseMulVector)->Apply(sizes);
+
+// Sparse n x n times a dense block of 64 vectors
+void BM_SparseMul(benchmark::State& state) {
+  int n = static_cast<int>(state.range(0));
+  S21SparseMatrix matrix = sparseMatrix(n);
+  S21Matrix block = randomMatrix(n, 64);
+  double nonZeros = static_cast<double>(matrix.getNonZeros());
+  measure(state, 2 * 64 * nonZeros, 2 * kDouble * 64 * n, [&] {
+    S21Matrix product = matrix * block;
+    benchmark::DoNotOptimize(product.getData());
+  });
+}
+BENCHMARK(BM_SparseMul)->Apply(sizes);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+#include "s21_cholesky_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_matrix_cholesky.h"
+
+template <class T>
+S21BasicCholeskySolver<T>::S21BasicCholeskySolver(
+    typename Matrix::ConstMatrixView matrix)
+    : factor_(matrix), pivots_(factor_.getRows()) {
+  if (matrix.getRows() != matrix.getCols()) {
+    throw std::invalid_argument("Matrix is not square");
+  }
+  const int n = getSize();
+  T* l = factor_.getData();
+  const int ld = factor_.getStride();
+  // largest magnitude in each row (and so column) from the lower triangle
+  std::vector<s21::RealOf<T>> scale(n, 0);
+  for (int i = 0; i < n; i++) {
+    const T* row = l + i * static_cast<std::ptrdiff_t>(ld);
+    for (int j = 0; j <= i; j++) {
+      s21::RealOf<T> value = std::abs(row[j]);
+      scale[i] = std::max(scale[i], value);
+      scale[j] = std::max(scale[j], value);
+    }
+  }
+  positiveDefinite_ = s21::CholeskyFactor(n, l, ld, pivots_.data());
+  // pivot i is the one LU would meet at step i without row exchanges,
+  // measured the way s21::LuSingular does
+  const s21::RealOf<T> epsilon =
+      n * std::numeric_limits<s21::RealOf<T>>::epsilon();
+  singular_ = !positiveDefinite_;
+  for (int i = 0; i < n && !singular_; i++) {
+    singular_ = !(pivots_[i] > epsilon * scale[i] &&
+                  pivots_[i] <= std::numeric_limits<s21::RealOf<T>>::max());
+  }
+}
+
+template <class T>
+void S21BasicCholeskySolver<T>::checkFactored() const {
+  if (!positiveDefinite_) {
+    throw std::invalid_argument("Matrix is not positive definite");
+  }
+}
+
+template <class T>
+void S21BasicCholeskySolver<T>::checkSolvable(int rows) const {
+  checkFactored();
+  if (rows != getSize()) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  } else if (singular_) {
+    throw std::invalid_argument("Matrix determinant is 0.");
+  }
+}
+
+template <class T>
+T S21BasicCholeskySolver<T>::Determinant() const {
+  checkFactored();
+  return s21::CholeskyDeterminant(getSize(), pivots_.data());
+}
+
+template <class T>
+std::vector<T> S21BasicCholeskySolver<T>::Solve(
+    const std::vector<T>& b) const {
+  checkSolvable(static_cast<int>(b.size()));
+  std::vector<T> x(b);
+  s21::CholeskySolve(getSize(), 1, factor_.getData(), factor_.getStride(),
+                     x.data(), 1);
+  return x;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicCholeskySolver<T>::Solve(
+    typename Matrix::ConstMatrixView b) const {
+  checkSolvable(b.getRows());
+  Matrix x(b);
+  s21::CholeskySolve(getSize(), x.getCols(), factor_.getData(),
+                     factor_.getStride(), x.getData(), x.getStride());
+  return x;
+}
+
+template <class T>
+void S21BasicCholeskySolver<T>::SolveInPlace(Matrix& b) const {
+  checkSolvable(b.getRows());
+  s21::CholeskySolve(getSize(), b.getCols(), factor_.getData(),
+                     factor_.getStride(), b.getData(), b.getStride());
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicCholeskySolver<T>::InverseMatrix() const {
+  const int n = getSize();
+  checkSolvable(n);
+  Matrix inverse(n, n);
+  s21::CholeskyInverse(n, factor_.getData(), factor_.getStride(),
+                       inverse.getData(), inverse.getStride());
+  return inverse;
+}
+
+template class S21BasicCholeskySolver<float>;
+template class S21BasicCholeskySolver<double>;
+template class S21BasicCholeskySolver<long double>;
+template class S21BasicCholeskySolver<std::complex<double>>;
@@ -0,0 +1,60 @@
+#ifndef S21_CHOLESKY_SOLVER_H_
+#define S21_CHOLESKY_SOLVER_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Cholesky factorization A = L * L^H of a Hermitian (real: symmetric)
+// positive-definite matrix such as a covariance or Gram matrix, computed
+// once by the constructor with about half the flops of LU and kept for
+// solves, the determinant and the inverse. Only the lower triangle of the
+// matrix is read. Instantiated for the same element types as S21BasicMatrix
+template <class T>
+class S21BasicCholeskySolver {
+ public:
+  using Matrix = S21BasicMatrix<T>;
+
+  // Throws "Matrix is not square" for a non-square matrix; one that is not
+  // positive definite is reported by isPositiveDefinite() instead
+  explicit S21BasicCholeskySolver(typename Matrix::ConstMatrixView matrix);
+
+  // accessors
+  int getSize() const { return factor_.getRows(); }
+  // L, zero above the diagonal
+  const Matrix& getFactor() const { return factor_; }
+  bool isPositiveDefinite() const { return positiveDefinite_; }
+  // Not positive definite, or a pivot vanished against its row (the test
+  // of s21::LuSingular)
+  bool isSingular() const { return singular_; }
+
+  // The solving calls throw "Matrix is not positive definite" if the
+  // factorization failed, and the LU solver's messages otherwise
+  T Determinant() const;
+  // x with A * x = b
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  // X with A * X = B, one right-hand side per column of B
+  Matrix Solve(typename Matrix::ConstMatrixView b) const;
+  // Solve() writing X over B, no allocation
+  void SolveInPlace(Matrix& b) const;
+  Matrix InverseMatrix() const;
+
+ private:
+  void checkFactored() const;
+  void checkSolvable(int rows) const;
+
+  Matrix factor_;
+  // A(i, i) - sum of |L(i, k)|^2 over k < i, L(i, i) before the root
+  std::vector<s21::RealOf<T>> pivots_;
+  bool positiveDefinite_;
+  bool singular_;
+};
+
+using S21CholeskySolver = S21BasicCholeskySolver<double>;
+
+extern template class S21BasicCholeskySolver<float>;
+extern template class S21BasicCholeskySolver<double>;
+extern template class S21BasicCholeskySolver<long double>;
+extern template class S21BasicCholeskySolver<std::complex<double>>;
+
+#endif
@@ -0,0 +1,330 @@
+#ifndef S21_FIXED_MATRIX_H_
+#define S21_FIXED_MATRIX_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+// Matrix with dimensions fixed at compile time. Elements live inside the
+// object (no heap allocation) and every operation is constexpr, so small
+// transforms with constant inputs can be evaluated by the compiler.
+// Determinant, complements and inverse use closed forms up to 4x4 and
+// Gaussian elimination above. Mirrors the S21Matrix interface and
+// converts to and from it.
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Wrong parameters for matrix");
+
+ public:
+  constexpr S21FixedMatrix() : matrix_{} {}
+
+  // Row-major values, missing trailing values are zero
+  constexpr S21FixedMatrix(std::initializer_list<double> values) : matrix_{} {
+    if (values.size() > static_cast<std::size_t>(R * C)) {
+      throw std::invalid_argument(
+          "Number of values does not match the matrix size");
+    }
+    int i = 0;
+    for (double value : values) {
+      matrix_[i / C][i % C] = value;
+      i++;
+    }
+  }
+
+  explicit S21FixedMatrix(const S21Matrix& other) : matrix_{} {
+    if (other.getRows() != R || other.getCols() != C) {
+      throw std::invalid_argument("Different matrix dimensions");
+    }
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) matrix_[i][j] = other.getMatrix()[i][j];
+    }
+  }
+
+  S21Matrix ToMatrix() const {
+    S21Matrix result(R, C);
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) result.getMatrix()[i][j] = matrix_[i][j];
+    }
+    return result;
+  }
+
+  // accessors
+  static constexpr int getRows() { return R; }
+  static constexpr int getCols() { return C; }
+
+  // matrix operations
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        double diff = matrix_[i][j] - other.matrix_[i][j];
+        if (diff > 1e-7 || diff < -1e-7) return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr void SumMatrix(const S21FixedMatrix& other) {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) matrix_[i][j] += other.matrix_[i][j];
+    }
+  }
+
+  constexpr void SubMatrix(const S21FixedMatrix& other) {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) matrix_[i][j] -= other.matrix_[i][j];
+    }
+  }
+
+  constexpr void MulNumber(const double num) {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) matrix_[i][j] *= num;
+    }
+  }
+
+  // In place product, only possible when the result keeps the same shape
+  constexpr void MulMatrix(const S21FixedMatrix<C, C>& other) {
+    *this = *this * other;
+  }
+
+  constexpr S21FixedMatrix<C, R> Transpose() const {
+    S21FixedMatrix<C, R> result;
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) result(j, i) = matrix_[i][j];
+    }
+    return result;
+  }
+
+  constexpr double Determinant() const {
+    static_assert(R == C, "Matrix is not square");
+    const auto& m = matrix_;
+    if constexpr (R == 1) {
+      return m[0][0];
+    } else if constexpr (R == 2) {
+      return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+    } else if constexpr (R == 3) {
+      return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+             m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+             m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    } else if constexpr (R == 4) {
+      Pairs p = pairs();
+      return p.s[0] * p.c[5] - p.s[1] * p.c[4] + p.s[2] * p.c[3] +
+             p.s[3] * p.c[2] - p.s[4] * p.c[1] + p.s[5] * p.c[0];
+    } else {
+      double scratch[R][R] = {};
+      for (int i = 0; i < R; i++) {
+        for (int j = 0; j < R; j++) scratch[i][j] = m[i][j];
+      }
+      return eliminate(scratch, R);
+    }
+  }
+
+  constexpr S21FixedMatrix CalcComplements() const {
+    static_assert(R == C, "Matrix is not square");
+    return adjugate().Transpose();
+  }
+
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "Matrix is not square");
+    double det = Determinant();
+    if (det == 0) {
+      throw std::invalid_argument("Matrix determinant is 0.");
+    }
+    S21FixedMatrix result = adjugate();
+    result.MulNumber(1 / det);
+    return result;
+  }
+
+  // operators overload
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix& other) const {
+    S21FixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix& other) const {
+    S21FixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K>& other) const {
+    S21FixedMatrix<R, K> result;
+    for (int i = 0; i < R; i++) {
+      for (int k = 0; k < C; k++) {
+        for (int j = 0; j < K; j++) result(i, j) += matrix_[i][k] * other(k, j);
+      }
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix operator*(const double num) const {
+    S21FixedMatrix result(*this);
+    result.MulNumber(num);
+    return result;
+  }
+
+  constexpr bool operator==(const S21FixedMatrix& other) const {
+    return EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) {
+    SumMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) {
+    SubMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(const S21FixedMatrix<C, C>& other) {
+    MulMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(const double num) {
+    MulNumber(num);
+    return *this;
+  }
+
+  constexpr double& operator()(int row, int col) {
+    checkIndex(row, col);
+    return matrix_[row][col];
+  }
+
+  constexpr double operator()(int row, int col) const {
+    checkIndex(row, col);
+    return matrix_[row][col];
+  }
+
+ private:
+  // 2x2 determinants of the top (s) and bottom (c) row pairs of a 4x4
+  struct Pairs {
+    double s[6];
+    double c[6];
+  };
+
+  constexpr Pairs pairs() const {
+    const auto& m = matrix_;
+    return {{m[0][0] * m[1][1] - m[1][0] * m[0][1],
+             m[0][0] * m[1][2] - m[1][0] * m[0][2],
+             m[0][0] * m[1][3] - m[1][0] * m[0][3],
+             m[0][1] * m[1][2] - m[1][1] * m[0][2],
+             m[0][1] * m[1][3] - m[1][1] * m[0][3],
+             m[0][2] * m[1][3] - m[1][2] * m[0][3]},
+            {m[2][0] * m[3][1] - m[3][0] * m[2][1],
+             m[2][0] * m[3][2] - m[3][0] * m[2][2],
+             m[2][0] * m[3][3] - m[3][0] * m[2][3],
+             m[2][1] * m[3][2] - m[3][1] * m[2][2],
+             m[2][1] * m[3][3] - m[3][1] * m[2][3],
+             m[2][2] * m[3][3] - m[3][2] * m[2][3]}};
+  }
+
+  // Transposed cofactor matrix
+  constexpr S21FixedMatrix adjugate() const {
+    const auto& m = matrix_;
+    S21FixedMatrix r;
+    if constexpr (R == 1) {
+      r.matrix_[0][0] = 1;
+    } else if constexpr (R == 2) {
+      r.matrix_[0][0] = m[1][1];
+      r.matrix_[0][1] = -m[0][1];
+      r.matrix_[1][0] = -m[1][0];
+      r.matrix_[1][1] = m[0][0];
+    } else if constexpr (R == 3) {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          int r0 = (j + 1) % 3, r1 = (j + 2) % 3;
+          int c0 = (i + 1) % 3, c1 = (i + 2) % 3;
+          r.matrix_[i][j] = m[r0][c0] * m[r1][c1] - m[r0][c1] * m[r1][c0];
+        }
+      }
+    } else if constexpr (R == 4) {
+      Pairs p = pairs();
+      const double* s = p.s;
+      const double* c = p.c;
+      r.matrix_[0][0] = m[1][1] * c[5] - m[1][2] * c[4] + m[1][3] * c[3];
+      r.matrix_[0][1] = -m[0][1] * c[5] + m[0][2] * c[4] - m[0][3] * c[3];
+      r.matrix_[0][2] = m[3][1] * s[5] - m[3][2] * s[4] + m[3][3] * s[3];
+      r.matrix_[0][3] = -m[2][1] * s[5] + m[2][2] * s[4] - m[2][3] * s[3];
+      r.matrix_[1][0] = -m[1][0] * c[5] + m[1][2] * c[2] - m[1][3] * c[1];
+      r.matrix_[1][1] = m[0][0] * c[5] - m[0][2] * c[2] + m[0][3] * c[1];
+      r.matrix_[1][2] = -m[3][0] * s[5] + m[3][2] * s[2] - m[3][3] * s[1];
+      r.matrix_[1][3] = m[2][0] * s[5] - m[2][2] * s[2] + m[2][3] * s[1];
+      r.matrix_[2][0] = m[1][0] * c[4] - m[1][1] * c[2] + m[1][3] * c[0];
+      r.matrix_[2][1] = -m[0][0] * c[4] + m[0][1] * c[2] - m[0][3] * c[0];
+      r.matrix_[2][2] = m[3][0] * s[4] - m[3][1] * s[2] + m[3][3] * s[0];
+      r.matrix_[2][3] = -m[2][0] * s[4] + m[2][1] * s[2] - m[2][3] * s[0];
+      r.matrix_[3][0] = -m[1][0] * c[3] + m[1][1] * c[1] - m[1][2] * c[0];
+      r.matrix_[3][1] = m[0][0] * c[3] - m[0][1] * c[1] + m[0][2] * c[0];
+      r.matrix_[3][2] = -m[3][0] * s[3] + m[3][1] * s[1] - m[3][2] * s[0];
+      r.matrix_[3][3] = m[2][0] * s[3] - m[2][1] * s[1] + m[2][2] * s[0];
+    } else {
+      // minors share one scratch array
+      double scratch[R][R] = {};
+      for (int x_row = 0; x_row < R; x_row++) {
+        for (int x_col = 0; x_col < R; x_col++) {
+          for (int i = 0, si = 0; i < R; i++) {
+            if (i == x_row) continue;
+            for (int j = 0, sj = 0; j < R; j++) {
+              if (j != x_col) scratch[si][sj++] = m[i][j];
+            }
+            si++;
+          }
+          double minor = eliminate(scratch, R - 1);
+          r.matrix_[x_col][x_row] = (x_row + x_col) % 2 ? -minor : minor;
+        }
+      }
+    }
+    return r;
+  }
+
+  // Determinant of the leading n x n block of a by Gaussian elimination
+  // with partial pivoting, a is destroyed
+  static constexpr double eliminate(double (&a)[R][R], int n) {
+    double det = 1;
+    for (int k = 0; k < n; k++) {
+      int pivot = k;
+      for (int i = k + 1; i < n; i++) {
+        if (abs(a[i][k]) > abs(a[pivot][k])) pivot = i;
+      }
+      if (a[pivot][k] == 0) return 0;
+      if (pivot != k) {
+        for (int j = 0; j < n; j++) {
+          double tmp = a[k][j];
+          a[k][j] = a[pivot][j];
+          a[pivot][j] = tmp;
+        }
+        det = -det;
+      }
+      det *= a[k][k];
+      for (int i = k + 1; i < n; i++) {
+        double l = a[i][k] / a[k][k];
+        for (int j = k + 1; j < n; j++) a[i][j] -= l * a[k][j];
+      }
+    }
+    return det;
+  }
+
+  static constexpr double abs(double value) {
+    return value < 0 ? -value : value;
+  }
+
+  constexpr void checkIndex(int row, int col) const {
+    if (row < 0 || col < 0) {
+      throw std::invalid_argument("Zero or negative parameters for matrix");
+    } else if (row >= R || col >= C) {
+      throw std::invalid_argument("There are no such parameters for matrix");
+    }
+  }
+
+  double matrix_[R][C];
+
+  template <int, int>
+  friend class S21FixedMatrix;
+};
+
+#endif
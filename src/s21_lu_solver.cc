@@ -0,0 +1,79 @@
+#include "s21_lu_solver.h"
+
+#include <stdexcept>
+
+#include "s21_matrix_lu.h"
+
+template <class T>
+S21BasicLuSolver<T>::S21BasicLuSolver(typename Matrix::ConstMatrixView matrix)
+    : factors_(matrix), pivots_(matrix.getRows()) {
+  if (matrix.getRows() != matrix.getCols()) {
+    throw std::invalid_argument("Matrix is not square");
+  }
+  const int n = getSize();
+  T* lu = factors_.getData();
+  const int ld = factors_.getStride();
+  std::vector<s21::RealOf<T>> rowMax(n), colMax(n);
+  s21::RowColumnMax(n, lu, ld, rowMax.data(), colMax.data());
+  s21::LuFactor(n, lu, ld, pivots_.data());
+  singular_ = s21::LuSingular(n, lu, ld, pivots_.data(), rowMax.data(),
+                              colMax.data());
+}
+
+template <class T>
+T S21BasicLuSolver<T>::Determinant() const {
+  return s21::LuDeterminant(getSize(), factors_.getData(),
+                            factors_.getStride(), pivots_.data());
+}
+
+template <class T>
+void S21BasicLuSolver<T>::checkSolvable(int rows) const {
+  if (rows != getSize()) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  } else if (singular_) {
+    throw std::invalid_argument("Matrix determinant is 0.");
+  }
+}
+
+template <class T>
+std::vector<T> S21BasicLuSolver<T>::Solve(const std::vector<T>& b) const {
+  checkSolvable(static_cast<int>(b.size()));
+  std::vector<T> x(b);
+  s21::LuSolve(getSize(), 1, factors_.getData(), factors_.getStride(),
+               pivots_.data(), x.data(), 1);
+  return x;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicLuSolver<T>::Solve(
+    typename Matrix::ConstMatrixView b) const {
+  checkSolvable(b.getRows());
+  Matrix x(b);
+  s21::LuSolve(getSize(), x.getCols(), factors_.getData(),
+               factors_.getStride(), pivots_.data(), x.getData(),
+               x.getStride());
+  return x;
+}
+
+template <class T>
+void S21BasicLuSolver<T>::SolveInPlace(Matrix& b) const {
+  checkSolvable(b.getRows());
+  s21::LuSolve(getSize(), b.getCols(), factors_.getData(),
+               factors_.getStride(), pivots_.data(), b.getData(),
+               b.getStride());
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicLuSolver<T>::InverseMatrix() const {
+  const int n = getSize();
+  checkSolvable(n);
+  Matrix inverse(n, n);
+  for (int i = 0; i < n; i++) inverse(i, i) = 1;
+  SolveInPlace(inverse);
+  return inverse;
+}
+
+template class S21BasicLuSolver<float>;
+template class S21BasicLuSolver<double>;
+template class S21BasicLuSolver<long double>;
+template class S21BasicLuSolver<std::complex<double>>;
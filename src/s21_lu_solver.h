@@ -0,0 +1,55 @@
+#ifndef S21_LU_SOLVER_H_
+#define S21_LU_SOLVER_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization of a square matrix, computed once by the constructor
+// (O(n^3)) and kept for any number of solves against the same system, each
+// O(n^2) per right-hand side: a row exchange, a forward substitution with
+// L and a back substitution with U. Instantiated for the same element types
+// as S21BasicMatrix
+template <class T>
+class S21BasicLuSolver {
+ public:
+  using Matrix = S21BasicMatrix<T>;
+
+  // Throws "Matrix is not square" for a non-square matrix; a singular one
+  // is still factored, but only Determinant() works on it
+  explicit S21BasicLuSolver(typename Matrix::ConstMatrixView matrix);
+
+  // accessors
+  int getSize() const { return factors_.getRows(); }
+  // L below the diagonal (unit diagonal implied) and U on and above it
+  const Matrix& getFactors() const { return factors_; }
+  // Row i was exchanged with row getPivots()[i] at step i
+  const std::vector<int>& getPivots() const { return pivots_; }
+  // A pivot vanished against its row and column (see s21::LuSingular)
+  bool isSingular() const { return singular_; }
+
+  T Determinant() const;
+  // x with A * x = b
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  // X with A * X = B for a block of right-hand sides, one per column of B
+  Matrix Solve(typename Matrix::ConstMatrixView b) const;
+  // Solve() writing X over B, no allocation
+  void SolveInPlace(Matrix& b) const;
+  Matrix InverseMatrix() const;
+
+ private:
+  void checkSolvable(int rows) const;
+
+  Matrix factors_;
+  std::vector<int> pivots_;
+  bool singular_;
+};
+
+using S21LuSolver = S21BasicLuSolver<double>;
+
+extern template class S21BasicLuSolver<float>;
+extern template class S21BasicLuSolver<double>;
+extern template class S21BasicLuSolver<long double>;
+extern template class S21BasicLuSolver<std::complex<double>>;
+
+#endif
@@ -0,0 +1,127 @@
+#include "s21_matrix_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace s21 {
+
+namespace {
+
+// Blocks are a kArenaAlignment-sized header followed by the buffer, the
+// header keeps the largest size class the buffer can serve (-1 for buffers
+// too big to cache)
+struct BlockHeader {
+  int sizeClass;
+};
+static_assert(sizeof(BlockHeader) <= kArenaAlignment, "header fits");
+
+thread_local Arena* currentArena = nullptr;
+
+std::size_t classBytes(int sizeClass) {
+  return kArenaAlignment << sizeClass;
+}
+
+// Smallest class holding bytes, -1 if none does
+int sizeClassOf(std::size_t bytes) {
+  for (int c = 0; c < kArenaClasses; c++) {
+    if (bytes <= classBytes(c)) return c;
+  }
+  return -1;
+}
+
+// Largest class a buffer of capacity bytes serves, -1 if it is too big
+int servedClass(std::size_t capacity) {
+  if (capacity > classBytes(kArenaClasses - 1)) return -1;
+  int sizeClass = 0;
+  while (sizeClass + 1 < kArenaClasses &&
+         classBytes(sizeClass + 1) <= capacity) {
+    sizeClass++;
+  }
+  return sizeClass;
+}
+
+BlockHeader* headerOf(void* buffer) {
+  return reinterpret_cast<BlockHeader*>(static_cast<char*>(buffer) -
+                                        kArenaAlignment);
+}
+
+void* heapBlock(std::size_t capacity) {
+  capacity = std::max(capacity, kArenaAlignment);
+  if (capacity > SIZE_MAX - kArenaAlignment) throw std::bad_alloc();
+  char* block = static_cast<char*>(::operator new(
+      kArenaAlignment + capacity, std::align_val_t(kArenaAlignment)));
+  reinterpret_cast<BlockHeader*>(block)->sizeClass = servedClass(capacity);
+  return block + kArenaAlignment;
+}
+
+void releaseBlock(void* buffer) {
+  ::operator delete(headerOf(buffer), std::align_val_t(kArenaAlignment));
+}
+
+}  // namespace
+
+Arena::Arena(std::size_t maxCachedBytes) : maxCachedBytes_(maxCachedBytes) {}
+
+Arena::~Arena() { Release(); }
+
+void Arena::Release() {
+  for (FreeBlock*& head : free_) {
+    while (head) {
+      FreeBlock* next = head->next;
+      releaseBlock(head);
+      head = next;
+    }
+  }
+  cachedBytes_ = 0;
+}
+
+void* Arena::take(int sizeClass) {
+  FreeBlock* block = free_[sizeClass];
+  if (!block) return nullptr;
+  free_[sizeClass] = block->next;
+  cachedBytes_ -= classBytes(sizeClass);
+  return block;
+}
+
+bool Arena::keep(void* block, int sizeClass) {
+  if (cachedBytes_ + classBytes(sizeClass) > maxCachedBytes_) return false;
+  FreeBlock* node = static_cast<FreeBlock*>(block);
+  node->next = free_[sizeClass];
+  free_[sizeClass] = node;
+  cachedBytes_ += classBytes(sizeClass);
+  return true;
+}
+
+ScopedArena::ScopedArena() : arena_(&own_), previous_(currentArena) {
+  currentArena = arena_;
+}
+
+ScopedArena::ScopedArena(Arena& arena)
+    : own_(0), arena_(&arena), previous_(currentArena) {
+  currentArena = arena_;
+}
+
+ScopedArena::~ScopedArena() { currentArena = previous_; }
+
+Arena* CurrentArena() { return currentArena; }
+
+void* AllocateBuffer(std::size_t bytes) {
+  int sizeClass = sizeClassOf(bytes);
+  if (!currentArena || sizeClass < 0) return heapBlock(bytes);
+  // inside an arena buffers are rounded up to their class so that they
+  // can serve any later request of the same class
+  if (void* block = currentArena->take(sizeClass)) return block;
+  return heapBlock(classBytes(sizeClass));
+}
+
+void FreeBuffer(void* buffer) {
+  if (!buffer) return;
+  int sizeClass = headerOf(buffer)->sizeClass;
+  if (sizeClass >= 0 && currentArena && currentArena->keep(buffer, sizeClass)) {
+    return;
+  }
+  releaseBlock(buffer);
+}
+
+}  // namespace s21
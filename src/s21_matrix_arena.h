@@ -0,0 +1,115 @@
+#ifndef S21_MATRIX_ARENA_H_
+#define S21_MATRIX_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace s21 {
+
+// Alignment of every buffer handed out (one cache line)
+constexpr std::size_t kArenaAlignment = 64;
+// Size classes are powers of two from kArenaAlignment bytes up to
+// kArenaAlignment << (kArenaClasses - 1) (1 MiB), larger buffers bypass the
+// cache and go straight to the global heap
+constexpr int kArenaClasses = 15;
+
+// Size-class cache of freed buffers. Buffers still come from the global
+// heap the first time, but while an arena is installed on a thread (see
+// ScopedArena) buffers freed on that thread are kept on per-class free
+// lists and handed out again, so a steady-state loop of matrix operations
+// stops calling the global allocator after its first iteration. Every
+// buffer records its class, so one may outlive the arena it came from or
+// be freed on another thread; it is then simply returned to the heap.
+// Only buffers allocated inside an arena are rounded up to their class
+class Arena {
+ public:
+  // Up to maxCachedBytes of freed buffers are kept, the rest are released
+  explicit Arena(std::size_t maxCachedBytes = std::size_t{64} << 20);
+  ~Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  std::size_t getCachedBytes() const { return cachedBytes_; }
+  std::size_t getMaxCachedBytes() const { return maxCachedBytes_; }
+  // Releases every cached buffer to the global heap
+  void Release();
+
+ private:
+  friend void* AllocateBuffer(std::size_t bytes);
+  friend void FreeBuffer(void* buffer);
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  void* take(int sizeClass);
+  bool keep(void* block, int sizeClass);
+
+  FreeBlock* free_[kArenaClasses] = {};
+  std::size_t cachedBytes_ = 0;
+  std::size_t maxCachedBytes_;
+};
+
+// Installs an arena as the current one of this thread for its lifetime,
+// restoring the previous one afterwards; scopes nest
+class ScopedArena {
+ public:
+  // Uses an arena of its own, released with the scope
+  ScopedArena();
+  // Uses arena, which must outlive the scope
+  explicit ScopedArena(Arena& arena);
+  ~ScopedArena();
+  ScopedArena(const ScopedArena&) = delete;
+  ScopedArena& operator=(const ScopedArena&) = delete;
+
+  Arena& getArena() const { return *arena_; }
+
+ private:
+  Arena own_;
+  Arena* arena_;
+  Arena* previous_;
+};
+
+// The arena installed on this thread, nullptr outside any ScopedArena
+Arena* CurrentArena();
+
+// kArenaAlignment-aligned uninitialized buffer of at least bytes bytes,
+// from the current arena's cache when possible. Throws std::bad_alloc for
+// a size the block header can not be added to
+void* AllocateBuffer(std::size_t bytes);
+// Returns a buffer from AllocateBuffer, to the current arena if there is
+// one with room left, otherwise to the global heap
+void FreeBuffer(void* buffer);
+
+// count * size, throws std::bad_alloc where that product does not fit in
+// std::size_t instead of letting a buffer size wrap
+inline std::size_t BufferBytes(std::size_t count, std::size_t size) {
+  if (size != 0 && count > SIZE_MAX / size) throw std::bad_alloc();
+  return count * size;
+}
+
+// Uninitialized scratch array of count trivial elements drawn from the
+// current arena, for the temporaries of factorizations and kernels
+template <class T>
+class ArenaBuffer {
+  static_assert(std::is_trivially_copyable_v<T>, "scratch holds raw values");
+
+ public:
+  explicit ArenaBuffer(std::size_t count)
+      : data_(static_cast<T*>(AllocateBuffer(BufferBytes(count, sizeof(T))))) {}
+  ~ArenaBuffer() { FreeBuffer(data_); }
+  ArenaBuffer(const ArenaBuffer&) = delete;
+  ArenaBuffer& operator=(const ArenaBuffer&) = delete;
+
+  T* data() const { return data_; }
+  T& operator[](std::size_t i) const { return data_[i]; }
+
+ private:
+  T* data_;
+};
+
+}  // namespace s21
+
+#endif
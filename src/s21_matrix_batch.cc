@@ -0,0 +1,455 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_matrix_arena.h"
+#include "s21_matrix_simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define S21_BATCH_AVX2 1
+#endif
+
+namespace {
+
+constexpr int kLanes = kBatchLanes;
+
+// The lane kernels below work on kLanes matrices whose element e of lane l
+// sits at a[e * ld + l]. Every innermost loop runs over the lanes, so the
+// compiler turns it into SIMD instructions; pivoting differs per lane and
+// is done with selects instead of branches. Comparisons are the quiet
+// builtins and divisions unconditional, otherwise the possible FP traps
+// keep the selects as branches. Bodies are always inlined into one
+// wrapper per instruction set
+#define S21_LANE_LOOP _Pragma("GCC ivdep") for (int l = 0; l < kLanes; l++)
+
+// Determinants of kLanes n x n matrices from src (stride ld): closed forms
+// up to 3x3, otherwise elimination with partial pivoting on a copy in a
+// (n * n * kLanes elements)
+__attribute__((always_inline)) inline void detLanes(
+    int n, const double* __restrict src, std::ptrdiff_t ld,
+    double* __restrict a, double* __restrict det) {
+  auto m = [src, ld](int e) { return src + e * ld; };
+  if (n == 1) {
+    S21_LANE_LOOP { det[l] = m(0)[l]; }
+    return;
+  } else if (n == 2) {
+    S21_LANE_LOOP { det[l] = m(0)[l] * m(3)[l] - m(1)[l] * m(2)[l]; }
+    return;
+  } else if (n == 3) {
+    S21_LANE_LOOP {
+      det[l] = m(0)[l] * (m(4)[l] * m(8)[l] - m(5)[l] * m(7)[l]) -
+               m(1)[l] * (m(3)[l] * m(8)[l] - m(5)[l] * m(6)[l]) +
+               m(2)[l] * (m(3)[l] * m(7)[l] - m(4)[l] * m(6)[l]);
+    }
+    return;
+  }
+  for (int e = 0; e < n * n; e++) {
+    const double* from = m(e);
+    double* to = a + e * kLanes;
+    S21_LANE_LOOP { to[l] = from[l]; }
+  }
+
+  auto at = [a, n](int i, int j) { return a + (i * n + j) * kLanes; };
+  double sign[kLanes];
+  S21_LANE_LOOP { sign[l] = 1; }
+  for (int k = 0; k < n; k++) {
+    double best[kLanes], pivot[kLanes];
+    S21_LANE_LOOP {
+      best[l] = std::abs(at(k, k)[l]);
+      pivot[l] = k;
+    }
+    for (int i = k + 1; i < n; i++) {
+      const double* aik = at(i, k);
+      const double row = i;
+      S21_LANE_LOOP {
+        double value = std::abs(aik[l]);
+        bool better = __builtin_isgreater(value, best[l]);
+        best[l] = better ? value : best[l];
+        pivot[l] = better ? row : pivot[l];
+      }
+    }
+    for (int i = k + 1; i < n; i++) {
+      const double row = i;
+      for (int j = k; j < n; j++) {
+        double* akj = at(k, j);
+        double* aij = at(i, j);
+        S21_LANE_LOOP {
+          bool swap = pivot[l] == row;
+          double upper = akj[l], lower = aij[l];
+          akj[l] = swap ? lower : upper;
+          aij[l] = swap ? upper : lower;
+        }
+      }
+    }
+    double inverse[kLanes];
+    const double* akk = at(k, k);
+    S21_LANE_LOOP {
+      sign[l] = pivot[l] != k ? -sign[l] : sign[l];
+      // a zero pivot leaves the column alone, the determinant is 0 anyway
+      double zero = akk[l] == 0;
+      inverse[l] = (1 - zero) / (akk[l] + zero);
+    }
+    for (int i = k + 1; i < n; i++) {
+      double factor[kLanes];
+      double* aik = at(i, k);
+      S21_LANE_LOOP { factor[l] = aik[l] * inverse[l]; }
+      for (int j = k + 1; j < n; j++) {
+        const double* akj = at(k, j);
+        double* aij = at(i, j);
+        S21_LANE_LOOP { aij[l] -= factor[l] * akj[l]; }
+      }
+    }
+  }
+  S21_LANE_LOOP { det[l] = sign[l]; }
+  for (int k = 0; k < n; k++) {
+    const double* akk = at(k, k);
+    S21_LANE_LOOP { det[l] *= akk[l]; }
+  }
+}
+
+// Gauss-Jordan inversion of kLanes n x n matrices held as [A | I] in the
+// n x 2n augmented a (ld == kLanes), the right half becomes the inverse.
+// singular[l] is set for lanes whose pivot is not finite or vanishes against
+// the largest magnitude in its row and column, as in s21::LuSingular;
+// scales is scratch for 2 * n * kLanes values
+__attribute__((always_inline)) inline void inverseLanes(
+    int n, double* __restrict a, double* __restrict scales,
+    double* __restrict singular) {
+  const int width = 2 * n;
+  auto at = [a, width](int i, int j) { return a + (i * width + j) * kLanes; };
+  // per lane row maxima, moved along with row swaps, then column maxima
+  auto rowMax = [scales](int i) { return scales + i * kLanes; };
+  auto colMax = [scales, n](int j) { return scales + (n + j) * kLanes; };
+  std::fill_n(scales, 2 * n * kLanes, 0.0);
+  for (int i = 0; i < n; i++) {
+    double* ri = rowMax(i);
+    for (int j = 0; j < n; j++) {
+      const double* aij = at(i, j);
+      double* cj = colMax(j);
+      S21_LANE_LOOP {
+        double value = std::abs(aij[l]);
+        ri[l] = std::max(ri[l], value);
+        cj[l] = std::max(cj[l], value);
+      }
+    }
+  }
+  const double epsilon = n * std::numeric_limits<double>::epsilon();
+  constexpr double kFinite = std::numeric_limits<double>::max();
+  S21_LANE_LOOP { singular[l] = 0; }
+
+  for (int k = 0; k < n; k++) {
+    double best[kLanes], pivot[kLanes];
+    S21_LANE_LOOP {
+      best[l] = std::abs(at(k, k)[l]);
+      pivot[l] = k;
+    }
+    for (int i = k + 1; i < n; i++) {
+      const double* aik = at(i, k);
+      const double row = i;
+      S21_LANE_LOOP {
+        double value = std::abs(aik[l]);
+        bool better = __builtin_isgreater(value, best[l]);
+        best[l] = better ? value : best[l];
+        pivot[l] = better ? row : pivot[l];
+      }
+    }
+    for (int i = k + 1; i < n; i++) {
+      const double row = i;
+      double* rk = rowMax(k);
+      double* ri = rowMax(i);
+      S21_LANE_LOOP {
+        bool swap = pivot[l] == row;
+        double upper = rk[l], lower = ri[l];
+        rk[l] = swap ? lower : upper;
+        ri[l] = swap ? upper : lower;
+      }
+      for (int j = k; j < width; j++) {
+        double* akj = at(k, j);
+        double* aij = at(i, j);
+        S21_LANE_LOOP {
+          bool swap = pivot[l] == row;
+          double upper = akj[l], lower = aij[l];
+          akj[l] = swap ? lower : upper;
+          aij[l] = swap ? upper : lower;
+        }
+      }
+    }
+
+    double inverse[kLanes];
+    double* akk = at(k, k);
+    const double* rk = rowMax(k);
+    const double* ck = colMax(k);
+    S21_LANE_LOOP {
+      double tolerance = epsilon * std::min(rk[l], ck[l]);
+      bool regular = (best[l] > tolerance) & (best[l] <= kFinite);
+      double vanishes = !regular;
+      singular[l] = std::max(singular[l], vanishes);
+      inverse[l] = (1 - vanishes) / (akk[l] + vanishes);
+    }
+    for (int j = k; j < width; j++) {
+      double* akj = at(k, j);
+      S21_LANE_LOOP { akj[l] *= inverse[l]; }
+    }
+    for (int i = 0; i < n; i++) {
+      if (i == k) continue;
+      double factor[kLanes];
+      const double* aik = at(i, k);
+      S21_LANE_LOOP { factor[l] = aik[l]; }
+      for (int j = k; j < width; j++) {
+        const double* akj = at(k, j);
+        double* aij = at(i, j);
+        S21_LANE_LOOP { aij[l] -= factor[l] * akj[l]; }
+      }
+    }
+  }
+}
+
+// c = a * b for kLanes (m x k) by (k x n) products, all with stride ld
+__attribute__((always_inline)) inline void mulLanes(
+    int m, int n, int k, const double* __restrict a,
+    const double* __restrict b, double* __restrict c, std::ptrdiff_t ld) {
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      double sum[kLanes] = {};
+      for (int p = 0; p < k; p++) {
+        const double* aip = a + (i * k + p) * ld;
+        const double* bpj = b + (p * n + j) * ld;
+        S21_LANE_LOOP { sum[l] += aip[l] * bpj[l]; }
+      }
+      double* cij = c + (i * n + j) * ld;
+      S21_LANE_LOOP { cij[l] = sum[l]; }
+    }
+  }
+}
+
+struct BatchKernels {
+  void (*det)(int n, const double* src, std::ptrdiff_t ld, double* a,
+              double* det);
+  void (*inverse)(int n, double* a, double* scales, double* singular);
+  void (*mul)(int m, int n, int k, const double* a, const double* b,
+              double* c, std::ptrdiff_t ld);
+};
+
+void detBase(int n, const double* src, std::ptrdiff_t ld, double* a,
+             double* det) {
+  detLanes(n, src, ld, a, det);
+}
+void inverseBase(int n, double* a, double* scales, double* singular) {
+  inverseLanes(n, a, scales, singular);
+}
+void mulBase(int m, int n, int k, const double* a, const double* b,
+             double* c, std::ptrdiff_t ld) {
+  mulLanes(m, n, k, a, b, c, ld);
+}
+
+#ifdef S21_BATCH_AVX2
+__attribute__((target("avx2,fma"))) void detAvx2(int n, const double* src,
+                                                 std::ptrdiff_t ld, double* a,
+                                                 double* det) {
+  detLanes(n, src, ld, a, det);
+}
+__attribute__((target("avx2,fma"))) void inverseAvx2(int n, double* a,
+                                                     double* scales,
+                                                     double* singular) {
+  inverseLanes(n, a, scales, singular);
+}
+__attribute__((target("avx2,fma"))) void mulAvx2(
+    int m, int n, int k, const double* a, const double* b, double* c,
+    std::ptrdiff_t ld) {
+  mulLanes(m, n, k, a, b, c, ld);
+}
+#endif
+
+// Kernels for the active SIMD level, AVX2 also needs FMA
+BatchKernels selectKernels() {
+#ifdef S21_BATCH_AVX2
+  static const bool fma = __builtin_cpu_supports("fma");
+  if (fma && s21::ActiveSimdLevel() >= s21::SimdLevel::kAvx2) {
+    return {detAvx2, inverseAvx2, mulAvx2};
+  }
+#endif
+  return {detBase, inverseBase, mulBase};
+}
+
+int roundToLanes(int count) {
+  return (count + kLanes - 1) / kLanes * kLanes;
+}
+
+}  // namespace
+
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols), stride_(roundToLanes(count)) {
+  if (count_ <= 0 || rows_ <= 0 || cols_ <= 0) {
+    throw std::invalid_argument("Wrong parameters for matrix");
+  }
+  std::size_t size =
+      s21::BufferBytes(static_cast<std::size_t>(rows_) * cols_, stride_);
+  data_ = static_cast<double*>(
+      s21::AllocateBuffer(s21::BufferBytes(size, sizeof(double))));
+  std::fill_n(data_, size, 0.0);
+}
+
+S21MatrixBatch::S21MatrixBatch(const S21MatrixBatch& other)
+    : S21MatrixBatch(other.count_, other.rows_, other.cols_) {
+  std::copy_n(other.data_, static_cast<std::size_t>(rows_) * cols_ * stride_,
+              data_);
+}
+
+S21MatrixBatch::S21MatrixBatch(S21MatrixBatch&& other) noexcept
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      data_(other.data_) {
+  other.count_ = other.rows_ = other.cols_ = other.stride_ = 0;
+  other.data_ = nullptr;
+}
+
+S21MatrixBatch::~S21MatrixBatch() { s21::FreeBuffer(data_); }
+
+S21MatrixBatch& S21MatrixBatch::operator=(const S21MatrixBatch& other) {
+  if (this != &other) {
+    S21MatrixBatch copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+S21MatrixBatch& S21MatrixBatch::operator=(S21MatrixBatch&& other) noexcept {
+  if (this != &other) {
+    S21MatrixBatch taken(std::move(other));
+    swap(taken);
+  }
+  return *this;
+}
+
+void S21MatrixBatch::swap(S21MatrixBatch& other) noexcept {
+  std::swap(count_, other.count_);
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(stride_, other.stride_);
+  std::swap(data_, other.data_);
+}
+
+double& S21MatrixBatch::operator()(int index, int row, int col) {
+  if (index < 0 || row < 0 || col < 0) {
+    throw std::invalid_argument("Zero or negative parameters for matrix");
+  } else if (index >= count_ || row >= rows_ || col >= cols_) {
+    throw std::invalid_argument("There are no such parameters for matrix");
+  }
+  return getLane(row, col)[index];
+}
+
+void S21MatrixBatch::Set(int index, const S21Matrix& matrix) {
+  if (matrix.getRows() != rows_ || matrix.getCols() != cols_) {
+    throw std::invalid_argument("Different matrix dimensions");
+  }
+  (*this)(index, 0, 0);  // range check
+  for (int i = 0; i < rows_; i++) {
+    const double* row = matrix.getMatrix()[i];
+    for (int j = 0; j < cols_; j++) getLane(i, j)[index] = row[j];
+  }
+}
+
+S21Matrix S21MatrixBatch::Get(int index) const {
+  if (index < 0 || index >= count_) {
+    throw std::invalid_argument("There are no such parameters for matrix");
+  }
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    double* row = result.getMatrix()[i];
+    for (int j = 0; j < cols_; j++) row[j] = getLane(i, j)[index];
+  }
+  return result;
+}
+
+std::vector<double> S21MatrixBatch::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix is not square");
+  }
+  const int n = rows_;
+  BatchKernels kernels = selectKernels();
+  std::vector<double> result(stride_);
+  s21::ArenaBuffer<double> lanes(static_cast<std::size_t>(n * n) * kLanes);
+  for (int m = 0; m < stride_; m += kLanes) {
+    kernels.det(n, data_ + m, stride_, lanes.data(), result.data() + m);
+  }
+  result.resize(count_);
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::InverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix is not square");
+  }
+  const int n = rows_;
+  BatchKernels kernels = selectKernels();
+  S21MatrixBatch result(count_, n, n);
+  s21::ArenaBuffer<double> lanes(static_cast<std::size_t>(2 * n * n) *
+                                 kLanes);
+  s21::ArenaBuffer<double> scales(static_cast<std::size_t>(2 * n) * kLanes);
+  double singular[kLanes];
+  for (int m = 0; m < stride_; m += kLanes) {
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < 2 * n; j++) {
+        double* lane = lanes.data() + (i * 2 * n + j) * kLanes;
+        if (j < n) {
+          std::copy_n(getLane(i, j) + m, kLanes, lane);
+        } else {
+          std::fill_n(lane, kLanes, j - n == i ? 1.0 : 0.0);
+        }
+      }
+    }
+    kernels.inverse(n, lanes.data(), scales.data(), singular);
+    for (int l = 0; l < std::min(kLanes, count_ - m); l++) {
+      if (singular[l] != 0) {
+        if (n == 1) {
+          throw std::invalid_argument(
+              "Scalar matrix is 0. Division by zero can not be done.");
+        }
+        throw std::invalid_argument("Matrix determinant is 0.");
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        std::copy_n(lanes.data() + (i * 2 * n + n + j) * kLanes, kLanes,
+                    result.getLane(i, j) + m);
+      }
+    }
+  }
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::Transpose() const {
+  S21MatrixBatch result(count_, cols_, rows_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      std::copy_n(getLane(i, j), stride_, result.getLane(j, i));
+    }
+  }
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::operator*(const S21MatrixBatch& other) const {
+  if (count_ != other.count_) {
+    throw std::invalid_argument("Different matrix dimensions");
+  } else if (cols_ != other.rows_) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  BatchKernels kernels = selectKernels();
+  S21MatrixBatch result(count_, rows_, other.cols_);
+  for (int m = 0; m < stride_; m += kLanes) {
+    kernels.mul(rows_, other.cols_, cols_, data_ + m, other.data_ + m,
+                result.data_ + m, stride_);
+  }
+  return result;
+}
+
+void S21MatrixBatch::MulMatrix(const S21MatrixBatch& other) {
+  S21MatrixBatch result = *this * other;
+  swap(result);
+}
@@ -0,0 +1,63 @@
+#ifndef S21_MATRIX_BATCH_H_
+#define S21_MATRIX_BATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Matrices are processed kBatchLanes at a time, one per SIMD lane
+constexpr int kBatchLanes = 8;
+
+// Many matrices of one shape in structure-of-arrays layout: the same
+// element of every matrix is stored contiguously, element (i, j) of matrix
+// m at getData()[(i * cols + j) * getStride() + m]. Batched operations run
+// across the matrices kBatchLanes at a time with one SIMD lane each, so
+// small matrices cost their arithmetic and not a call and an allocation
+// apiece. The lanes past getCount() are zero padding, computed along and
+// ignored
+class S21MatrixBatch {
+ public:
+  S21MatrixBatch(int count, int rows, int cols);
+  S21MatrixBatch(const S21MatrixBatch& other);
+  S21MatrixBatch(S21MatrixBatch&& other) noexcept;
+  ~S21MatrixBatch();
+  S21MatrixBatch& operator=(const S21MatrixBatch& other);
+  S21MatrixBatch& operator=(S21MatrixBatch&& other) noexcept;
+
+  // accessors
+  int getCount() const { return count_; }
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  // Distance in elements between the lanes of two consecutive elements
+  int getStride() const { return stride_; }
+  double* getData() const { return data_; }
+  // Element (row, col) of every matrix, getCount() values in a row
+  double* getLane(int row, int col) const {
+    return data_ + static_cast<std::ptrdiff_t>(row * cols_ + col) * stride_;
+  }
+
+  // Element (row, col) of matrix index
+  double& operator()(int index, int row, int col);
+  // Copies of a single matrix in and out of the batch
+  void Set(int index, const S21Matrix& matrix);
+  S21Matrix Get(int index) const;
+
+  // batched operations, each throws like its S21Matrix counterpart
+  std::vector<double> Determinant() const;
+  // Throws if any matrix of the batch is singular
+  S21MatrixBatch InverseMatrix() const;
+  S21MatrixBatch Transpose() const;
+  // Matrix by matrix products
+  void MulMatrix(const S21MatrixBatch& other);
+  S21MatrixBatch operator*(const S21MatrixBatch& other) const;
+
+ private:
+  void swap(S21MatrixBatch& other) noexcept;
+
+  int count_, rows_, cols_;
+  int stride_;
+  double* data_;
+};
+
+#endif
@@ -0,0 +1,255 @@
+#include "s21_matrix_cholesky.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <functional>
+
+#include "s21_matrix_arena.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_transpose.h"
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+std::atomic<bool> spdDetection{true};
+
+// task(0) ... task(count - 1) on the default pool once a step does at least
+// kGemmParallel multiply-adds, inline below that
+void forBlocks(int count, long work, const std::function<void(int)>& task) {
+  if (work >= kGemmParallel) {
+    DefaultThreadPool().ParallelFor(count, task);
+  } else {
+    for (int i = 0; i < count; i++) task(i);
+  }
+}
+
+// dst (cols x rows, row stride ldd) = src^H for the rows x cols src
+template <class T>
+void conjTranspose(int rows, int cols, const T* src, int lds, T* dst,
+                   int ldd) {
+  TransposeCopy(rows, cols, src, lds, dst, ldd);
+  if constexpr (kIsComplex<T>) {
+    for (int i = 0; i < cols; i++) {
+      T* row = dst + i * static_cast<std::ptrdiff_t>(ldd);
+      for (int j = 0; j < rows; j++) row[j] = std::conj(row[j]);
+    }
+  }
+}
+
+}  // namespace
+
+template <class T>
+bool CholeskyFactor(int n, T* a, int lda, RealOf<T>* pivots) {
+  auto row = [a, lda](int i) {
+    return a + i * static_cast<std::ptrdiff_t>(lda);
+  };
+  const auto axpy = SimdFor<T>().axpy;
+  // L11^H of the current panel and L21^H below it, rows contiguous
+  ArenaBuffer<T> upper(static_cast<std::size_t>(kCholeskyBlock) *
+                       kCholeskyBlock);
+  ArenaBuffer<T> panel(static_cast<std::size_t>(kCholeskyBlock) * n);
+
+  for (int j0 = 0; j0 < n; j0 += kCholeskyBlock) {
+    const int jend = std::min(j0 + kCholeskyBlock, n);
+    const int nb = jend - j0;
+
+    // diagonal block, left-looking within the panel
+    for (int j = j0; j < jend; j++) {
+      T* rj = row(j);
+      RealOf<T> d = std::real(rj[j]);
+      for (int k = j0; k < j; k++) d -= std::norm(rj[k]);
+      if (!(d > 0)) return false;
+      pivots[j] = d;
+      const RealOf<T> ljj = std::sqrt(d);
+      rj[j] = ljj;
+      for (int i = j + 1; i < jend; i++) {
+        T* ri = row(i);
+        T sum = ri[j];
+        for (int k = j0; k < j; k++) sum -= ri[k] * Conj(rj[k]);
+        ri[j] = sum / ljj;
+      }
+    }
+
+    if (jend == n) break;
+
+    // L21 = A21 * L11^-H: each row x solves x * L11^H = a left to right,
+    // the updates are axpys with the rows of L11^H
+    conjTranspose(nb, nb, row(j0) + j0, lda, upper.data(), nb);
+    const int rest = n - jend;
+    const int blocks = (rest + kCholeskyBlock - 1) / kCholeskyBlock;
+    forBlocks(blocks, static_cast<long>(rest) * nb * nb, [&](int block) {
+      int i1 = std::min(jend + (block + 1) * kCholeskyBlock, n);
+      for (int i = jend + block * kCholeskyBlock; i < i1; i++) {
+        T* x = row(i) + j0;
+        for (int k = 0; k < nb; k++) {
+          const T* u = upper.data() + static_cast<std::size_t>(k) * nb;
+          x[k] /= u[k];
+          axpy(x + k + 1, u + k + 1, -x[k], nb - k - 1);
+        }
+      }
+    });
+
+    // A22 -= L21 * L21^H on and below the diagonal: row block r only
+    // needs the columns up to its own last row
+    conjTranspose(rest, nb, row(jend) + j0, lda, panel.data(), rest);
+    forBlocks(blocks, static_cast<long>(rest) * rest * nb / 2,
+              [&](int block) {
+                int i0 = block * kCholeskyBlock;
+                int i1 = std::min(i0 + kCholeskyBlock, rest);
+                Gemm(i1 - i0, i1, nb, row(jend + i0) + j0, lda,
+                     panel.data(), rest, row(jend + i0) + jend, lda, T(-1));
+              });
+  }
+
+  for (int i = 0; i < n; i++) std::fill(row(i) + i + 1, row(i) + n, T(0));
+  return true;
+}
+
+template <class T>
+void CholeskySolve(int n, int nrhs, const T* l, int lda, T* b, int ldb) {
+  auto lRow = [l, lda](int i) {
+    return l + i * static_cast<std::ptrdiff_t>(lda);
+  };
+  auto row = [b, ldb](int i) {
+    return b + i * static_cast<std::ptrdiff_t>(ldb);
+  };
+  const auto axpy = SimdFor<T>().axpy;
+  const auto scale = SimdFor<T>().scale;
+
+  // L * Y = B, block rows first take the contribution of everything above
+  // them through Gemm
+  for (int i0 = 0; i0 < n; i0 += kCholeskyBlock) {
+    int i1 = std::min(i0 + kCholeskyBlock, n);
+    Gemm(i1 - i0, nrhs, i0, lRow(i0), lda, row(0), ldb, row(i0), ldb, T(-1));
+    for (int i = i0; i < i1; i++) {
+      for (int k = i0; k < i; k++) axpy(row(i), row(k), -lRow(i)[k], nrhs);
+      scale(row(i), row(i), T(1) / lRow(i)[i], nrhs);
+    }
+  }
+
+  // L^H * X = Y, bottom block first; the block row of L^H right of the
+  // diagonal is a conjugated copy of a column panel of L
+  ArenaBuffer<T> panel(static_cast<std::size_t>(kCholeskyBlock) * n);
+  for (int i0 = (n - 1) / kCholeskyBlock * kCholeskyBlock; i0 >= 0;
+       i0 -= kCholeskyBlock) {
+    int i1 = std::min(i0 + kCholeskyBlock, n);
+    if (i1 < n) {
+      conjTranspose(n - i1, i1 - i0, lRow(i1) + i0, lda, panel.data(),
+                    n - i1);
+      Gemm(i1 - i0, nrhs, n - i1, panel.data(), n - i1, row(i1), ldb,
+           row(i0), ldb, T(-1));
+    }
+    for (int i = i1 - 1; i >= i0; i--) {
+      for (int k = i + 1; k < i1; k++) {
+        axpy(row(i), row(k), -Conj(lRow(k)[i]), nrhs);
+      }
+      scale(row(i), row(i), T(1) / lRow(i)[i], nrhs);
+    }
+  }
+}
+
+template <class T>
+void CholeskyInverse(int n, const T* l, int lda, T* inv, int ldi) {
+  auto lRow = [l, lda](int i) {
+    return l + i * static_cast<std::ptrdiff_t>(lda);
+  };
+  auto row = [inv, ldi](int i) {
+    return inv + i * static_cast<std::ptrdiff_t>(ldi);
+  };
+  const auto axpy = SimdFor<T>().axpy;
+  const auto scale = SimdFor<T>().scale;
+  for (int i = 0; i < n; i++) {
+    std::fill_n(row(i), n, T(0));
+    row(i)[i] = T(1);
+  }
+
+  // Y = L^-1 is lower triangular, so only the first i + 1 entries of row i
+  // take part, and the rows above a block only reach its first i0 columns
+  for (int i0 = 0; i0 < n; i0 += kCholeskyBlock) {
+    int i1 = std::min(i0 + kCholeskyBlock, n);
+    Gemm(i1 - i0, i0, i0, lRow(i0), lda, row(0), ldi, row(i0), ldi, T(-1));
+    for (int i = i0; i < i1; i++) {
+      for (int k = i0; k < i; k++) axpy(row(i), row(k), -lRow(i)[k], k + 1);
+      scale(row(i), row(i), T(1) / lRow(i)[i], i + 1);
+    }
+  }
+
+  // X = L^-H * Y is Hermitian: its lower triangle is built bottom block
+  // first, as row i only needs the first i + 1 entries of the rows below
+  ArenaBuffer<T> panel(static_cast<std::size_t>(kCholeskyBlock) * n);
+  for (int i0 = (n - 1) / kCholeskyBlock * kCholeskyBlock; i0 >= 0;
+       i0 -= kCholeskyBlock) {
+    int i1 = std::min(i0 + kCholeskyBlock, n);
+    if (i1 < n) {
+      conjTranspose(n - i1, i1 - i0, lRow(i1) + i0, lda, panel.data(),
+                    n - i1);
+      Gemm(i1 - i0, i1, n - i1, panel.data(), n - i1, row(i1), ldi, row(i0),
+           ldi, T(-1));
+    }
+    for (int i = i1 - 1; i >= i0; i--) {
+      for (int k = i + 1; k < i1; k++) {
+        axpy(row(i), row(k), -Conj(lRow(k)[i]), i + 1);
+      }
+      scale(row(i), row(i), T(1) / lRow(i)[i], i + 1);
+    }
+  }
+
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) row(i)[j] = Conj(row(j)[i]);
+  }
+}
+
+template <class R>
+R CholeskyDeterminant(int n, const R* pivots) {
+  R result = 1;
+  for (int i = 0; i < n; i++) result *= pivots[i];
+  return result;
+}
+
+template <class T>
+bool IsHermitian(int n, const T* a, int lda) {
+  auto at = [a, lda](int i, int j) {
+    return a[i * static_cast<std::ptrdiff_t>(lda) + j];
+  };
+  for (int i0 = 0; i0 < n; i0 += kTransposeBlock) {
+    int i1 = std::min(i0 + kTransposeBlock, n);
+    for (int j0 = 0; j0 <= i0; j0 += kTransposeBlock) {
+      for (int i = i0; i < i1; i++) {
+        for (int j = j0, j1 = std::min(j0 + kTransposeBlock, i + 1); j < j1;
+             j++) {
+          if (at(i, j) != Conj(at(j, i))) return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SpdDetection() { return spdDetection.load(std::memory_order_relaxed); }
+
+void SetSpdDetection(bool enabled) {
+  spdDetection.store(enabled, std::memory_order_relaxed);
+}
+
+#define S21_CHOLESKY_INSTANTIATE(T)                               \
+  template bool CholeskyFactor(int, T*, int, RealOf<T>*);         \
+  template void CholeskySolve(int, int, const T*, int, T*, int);  \
+  template void CholeskyInverse(int, const T*, int, T*, int);     \
+  template bool IsHermitian(int, const T*, int);
+
+S21_CHOLESKY_INSTANTIATE(float)
+S21_CHOLESKY_INSTANTIATE(double)
+S21_CHOLESKY_INSTANTIATE(long double)
+S21_CHOLESKY_INSTANTIATE(std::complex<double>)
+
+template float CholeskyDeterminant(int, const float*);
+template double CholeskyDeterminant(int, const double*);
+template long double CholeskyDeterminant(int, const long double*);
+
+}  // namespace s21
@@ -0,0 +1,56 @@
+#ifndef S21_MATRIX_CHOLESKY_H_
+#define S21_MATRIX_CHOLESKY_H_
+
+#include "s21_matrix_scalar.h"
+
+namespace s21 {
+
+// Cholesky routines for Hermitian (real: symmetric) positive-definite
+// matrices, A = L * L^H with L lower triangular. They take about half the
+// flops of the LU ones. Instantiated for the matrix element types (see
+// s21_matrix_scalar.h)
+
+// Panel width of the blocked factorization and of the blocked solves
+constexpr int kCholeskyBlock = 64;
+
+// In-place factorization of the n x n row-major matrix a (row stride lda),
+// reading only its lower triangle: on success the lower triangle holds L
+// and the strict upper triangle is zeroed, pivots (n entries) receives the
+// squares of its diagonal before rounding by the square root. Returns
+// false as soon as a pivot is not positive, i.e. A is not positive
+// definite, leaving a partly overwritten. Trailing updates touch only the
+// lower triangle and are split by row blocks across s21::DefaultThreadPool()
+// when large
+template <class T>
+bool CholeskyFactor(int n, T* a, int lda, RealOf<T>* pivots);
+
+// Solves A * X = B in place for the n x nrhs row-major block b (row stride
+// ldb), given the output of CholeskyFactor for A
+template <class T>
+void CholeskySolve(int n, int nrhs, const T* l, int lda, T* b, int ldb);
+
+// inv = A^-1 from the output of CholeskyFactor: L^-1 and then the lower
+// triangle of L^-H * L^-1 are formed, the upper one is mirrored from it
+template <class T>
+void CholeskyInverse(int n, const T* l, int lda, T* inv, int ldi);
+
+// det(A), the product of the pivots from CholeskyFactor
+template <class R>
+R CholeskyDeterminant(int n, const R* pivots);
+
+// True if a(i, j) == conj(a(j, i)) exactly for every i, j of the n x n
+// matrix a; compares tile against mirrored tile and stops at the first
+// mismatch
+template <class T>
+bool IsHermitian(int n, const T* a, int lda);
+
+// Whether S21Matrix::Determinant(), InverseMatrix() and CalcComplements()
+// check for a Hermitian matrix and try CholeskyFactor before LU (on by
+// default); a matrix that turns out not to be positive definite falls back
+// to LU
+bool SpdDetection();
+void SetSpdDetection(bool enabled);
+
+}  // namespace s21
+
+#endif
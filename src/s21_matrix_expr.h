@@ -0,0 +1,174 @@
+#ifndef S21_MATRIX_EXPR_H_
+#define S21_MATRIX_EXPR_H_
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+// Lazy element-wise arithmetic over S21Matrix. An expression started with
+// s21::Lazy(m) only records its operands; `+`, `-`, unary `-` and scaling
+// by a number build a tree of small value types, and the whole tree is
+// evaluated in one fused loop when it is assigned to (or used to construct)
+// an S21Matrix:
+//
+//   S21Matrix r = (s21::Lazy(a) + b) * 2.0 - c;  // one pass, no temporaries
+//
+// Operands are referenced, not copied, so every matrix used in an
+// expression has to outlive its evaluation.
+
+namespace s21 {
+
+// CRTP base of all expressions, E provides getRows(), getCols() and the
+// element at a row-major linear index
+template <class E>
+class MatrixExpr {
+ public:
+  const E& self() const { return static_cast<const E&>(*this); }
+  int getRows() const { return self().getRows(); }
+  int getCols() const { return self().getCols(); }
+  double operator[](std::size_t i) const { return self()[i]; }
+};
+
+// Leaf referring to the storage of an S21Matrix
+class MatrixLeaf : public MatrixExpr<MatrixLeaf> {
+ public:
+  explicit MatrixLeaf(const S21Matrix& matrix)
+      : data_(matrix.getData()),
+        rows_(matrix.getRows()),
+        cols_(matrix.getCols()) {}
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  double operator[](std::size_t i) const { return data_[i]; }
+
+ private:
+  const double* data_;
+  int rows_, cols_;
+};
+
+struct PlusOp {
+  static double apply(double a, double b) { return a + b; }
+};
+
+struct MinusOp {
+  static double apply(double a, double b) { return a - b; }
+};
+
+template <class L, class R, class Op>
+class BinaryExpr : public MatrixExpr<BinaryExpr<L, R, Op>> {
+ public:
+  BinaryExpr(const L& left, const R& right) : left_(left), right_(right) {
+    if (left_.getRows() != right_.getRows() ||
+        left_.getCols() != right_.getCols()) {
+      throw std::invalid_argument("Different matrix dimensions");
+    }
+  }
+  int getRows() const { return left_.getRows(); }
+  int getCols() const { return left_.getCols(); }
+  double operator[](std::size_t i) const {
+    return Op::apply(left_[i], right_[i]);
+  }
+
+ private:
+  L left_;
+  R right_;
+};
+
+template <class E>
+class ScaledExpr : public MatrixExpr<ScaledExpr<E>> {
+ public:
+  ScaledExpr(const E& expr, double num) : expr_(expr), num_(num) {}
+  int getRows() const { return expr_.getRows(); }
+  int getCols() const { return expr_.getCols(); }
+  double operator[](std::size_t i) const { return expr_[i] * num_; }
+
+ private:
+  E expr_;
+  double num_;
+};
+
+// Starts a lazy expression over matrix
+inline MatrixLeaf Lazy(const S21Matrix& matrix) { return MatrixLeaf(matrix); }
+
+template <class L, class R>
+BinaryExpr<L, R, PlusOp> operator+(const MatrixExpr<L>& left,
+                                   const MatrixExpr<R>& right) {
+  return BinaryExpr<L, R, PlusOp>(left.self(), right.self());
+}
+
+template <class L>
+BinaryExpr<L, MatrixLeaf, PlusOp> operator+(const MatrixExpr<L>& left,
+                                            const S21Matrix& right) {
+  return BinaryExpr<L, MatrixLeaf, PlusOp>(left.self(), MatrixLeaf(right));
+}
+
+template <class R>
+BinaryExpr<MatrixLeaf, R, PlusOp> operator+(const S21Matrix& left,
+                                            const MatrixExpr<R>& right) {
+  return BinaryExpr<MatrixLeaf, R, PlusOp>(MatrixLeaf(left), right.self());
+}
+
+template <class L, class R>
+BinaryExpr<L, R, MinusOp> operator-(const MatrixExpr<L>& left,
+                                    const MatrixExpr<R>& right) {
+  return BinaryExpr<L, R, MinusOp>(left.self(), right.self());
+}
+
+template <class L>
+BinaryExpr<L, MatrixLeaf, MinusOp> operator-(const MatrixExpr<L>& left,
+                                             const S21Matrix& right) {
+  return BinaryExpr<L, MatrixLeaf, MinusOp>(left.self(), MatrixLeaf(right));
+}
+
+template <class R>
+BinaryExpr<MatrixLeaf, R, MinusOp> operator-(const S21Matrix& left,
+                                             const MatrixExpr<R>& right) {
+  return BinaryExpr<MatrixLeaf, R, MinusOp>(MatrixLeaf(left), right.self());
+}
+
+template <class E>
+ScaledExpr<E> operator*(const MatrixExpr<E>& expr, double num) {
+  return ScaledExpr<E>(expr.self(), num);
+}
+
+template <class E>
+ScaledExpr<E> operator*(double num, const MatrixExpr<E>& expr) {
+  return ScaledExpr<E>(expr.self(), num);
+}
+
+template <class E>
+ScaledExpr<E> operator-(const MatrixExpr<E>& expr) {
+  return ScaledExpr<E>(expr.self(), -1.0);
+}
+
+}  // namespace s21
+
+// Evaluation of an expression into a new matrix
+template <class T>
+template <class E>
+S21BasicMatrix<T>::S21BasicMatrix(const s21::MatrixExpr<E>& expr)
+    : S21BasicMatrix(expr.getRows(), expr.getCols()) {
+  *this = expr;
+}
+
+// Evaluation of an expression into this matrix, its buffer is reused when
+// the size matches (the matrix itself may appear in the expression)
+template <class T>
+template <class E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    const s21::MatrixExpr<E>& expr) {
+  if (rows_ != expr.getRows() || cols_ != expr.getCols() || !matrix_) {
+    memFree();
+    rows_ = expr.getRows();
+    cols_ = expr.getCols();
+    memAlloc(rows_, cols_);
+  }
+  touch();
+  const E& e = expr.self();
+  for (std::size_t i = 0, size = getSize(); i < size; i++) {
+    matrix_[i] = e[i];
+  }
+  return *this;
+}
+
+#endif
@@ -0,0 +1,497 @@
+#include "s21_matrix_gemm.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "s21_matrix_arena.h"
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define S21_GEMM_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+// Products below this many multiply-adds skip packing entirely
+constexpr long kGemmSmall = 32L * 32L * 32L;
+
+// Width of the register tile for the packed element types: a tile row
+// spans the same two vector registers, so it holds twice as many floats
+template <class T>
+constexpr int kPackedNR =
+    kGemmNR * static_cast<int>(sizeof(double) / sizeof(T));
+
+template <class T>
+struct AlignedDelete {
+  void operator()(T* p) const { ::operator delete[](p, std::align_val_t(64)); }
+};
+
+// Per-thread packing buffer, grown on demand and reused between calls
+template <class T>
+T* packBuffer(std::size_t count) {
+  thread_local std::unique_ptr<T[], AlignedDelete<T>> buffer;
+  thread_local std::size_t capacity = 0;
+  if (capacity < count) {
+    buffer.reset(static_cast<T*>(
+        ::operator new[](count * sizeof(T), std::align_val_t(64))));
+    capacity = count;
+  }
+  return buffer.get();
+}
+
+// Packs alpha times a mc x kc block of A (strides rs, cs) into kMR-tall
+// row slivers, each stored column by column, zero padding the last sliver
+template <class T>
+void packA(int mc, int kc, const T* a, int rs, int cs, T alpha, T* packed) {
+  for (int i = 0; i < mc; i += kGemmMR) {
+    int rows = std::min(kGemmMR, mc - i);
+    const T* block = a + i * static_cast<std::ptrdiff_t>(rs);
+    for (int p = 0; p < kc; p++) {
+      const T* column = block + p * static_cast<std::ptrdiff_t>(cs);
+      for (int r = 0; r < rows; r++) {
+        packed[r] = alpha * column[r * static_cast<std::ptrdiff_t>(rs)];
+      }
+      for (int r = rows; r < kGemmMR; r++) packed[r] = T(0);
+      packed += kGemmMR;
+    }
+  }
+}
+
+// Packs a kc x nc panel of B (strides rs, cs) into kPackedNR-wide column
+// slivers, each stored row by row, zero padding the last sliver
+template <class T>
+void packB(int kc, int nc, const T* b, int rs, int cs, T* packed) {
+  constexpr int nr = kPackedNR<T>;
+  for (int j = 0; j < nc; j += nr) {
+    int cols = std::min(nr, nc - j);
+    const T* block = b + j * static_cast<std::ptrdiff_t>(cs);
+    for (int p = 0; p < kc; p++) {
+      const T* row = block + p * static_cast<std::ptrdiff_t>(rs);
+      if (cs == 1) {
+        for (int c = 0; c < cols; c++) packed[c] = row[c];
+      } else {
+        for (int c = 0; c < cols; c++) {
+          packed[c] = row[c * static_cast<std::ptrdiff_t>(cs)];
+        }
+      }
+      for (int c = cols; c < nr; c++) packed[c] = T(0);
+      packed += nr;
+    }
+  }
+}
+
+// Accumulator of one kMR x kPackedNR tile
+template <class T>
+using TileAcc = T[kGemmMR][kPackedNR<T>];
+
+// Accumulates a kMR x 4 block of packed A * packed B into acc, starting at
+// column col of the kNR-wide B sliver
+void microTile4x4(int kc, const double* __restrict a,
+                  const double* __restrict b, int col, TileAcc<double>& acc) {
+#ifdef __SSE2__
+  __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+  __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+  __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+  __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+  b += col;
+  for (int p = 0; p < kc; p++) {
+    __m128d b0 = _mm_load_pd(b);
+    __m128d b1 = _mm_load_pd(b + 2);
+    __m128d a0 = _mm_set1_pd(a[0]);
+    c00 = _mm_add_pd(c00, _mm_mul_pd(a0, b0));
+    c01 = _mm_add_pd(c01, _mm_mul_pd(a0, b1));
+    __m128d a1 = _mm_set1_pd(a[1]);
+    c10 = _mm_add_pd(c10, _mm_mul_pd(a1, b0));
+    c11 = _mm_add_pd(c11, _mm_mul_pd(a1, b1));
+    __m128d a2 = _mm_set1_pd(a[2]);
+    c20 = _mm_add_pd(c20, _mm_mul_pd(a2, b0));
+    c21 = _mm_add_pd(c21, _mm_mul_pd(a2, b1));
+    __m128d a3 = _mm_set1_pd(a[3]);
+    c30 = _mm_add_pd(c30, _mm_mul_pd(a3, b0));
+    c31 = _mm_add_pd(c31, _mm_mul_pd(a3, b1));
+    a += kGemmMR;
+    b += kGemmNR;
+  }
+  _mm_storeu_pd(&acc[0][col], c00);
+  _mm_storeu_pd(&acc[0][col + 2], c01);
+  _mm_storeu_pd(&acc[1][col], c10);
+  _mm_storeu_pd(&acc[1][col + 2], c11);
+  _mm_storeu_pd(&acc[2][col], c20);
+  _mm_storeu_pd(&acc[2][col + 2], c21);
+  _mm_storeu_pd(&acc[3][col], c30);
+  _mm_storeu_pd(&acc[3][col + 2], c31);
+#else
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < kGemmMR; i++) {
+      for (int j = col; j < col + 4; j++) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+    a += kGemmMR;
+    b += kGemmNR;
+  }
+#endif
+}
+
+// Same kMR x 8 block for float, columns col to col + 7 of a kPackedNR-wide
+// sliver
+void microTile4x8(int kc, const float* __restrict a,
+                  const float* __restrict b, int col, TileAcc<float>& acc) {
+  constexpr int nr = kPackedNR<float>;
+#ifdef __SSE2__
+  __m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps();
+  __m128 c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+  __m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps();
+  __m128 c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+  b += col;
+  for (int p = 0; p < kc; p++) {
+    __m128 b0 = _mm_load_ps(b);
+    __m128 b1 = _mm_load_ps(b + 4);
+    __m128 a0 = _mm_set1_ps(a[0]);
+    c00 = _mm_add_ps(c00, _mm_mul_ps(a0, b0));
+    c01 = _mm_add_ps(c01, _mm_mul_ps(a0, b1));
+    __m128 a1 = _mm_set1_ps(a[1]);
+    c10 = _mm_add_ps(c10, _mm_mul_ps(a1, b0));
+    c11 = _mm_add_ps(c11, _mm_mul_ps(a1, b1));
+    __m128 a2 = _mm_set1_ps(a[2]);
+    c20 = _mm_add_ps(c20, _mm_mul_ps(a2, b0));
+    c21 = _mm_add_ps(c21, _mm_mul_ps(a2, b1));
+    __m128 a3 = _mm_set1_ps(a[3]);
+    c30 = _mm_add_ps(c30, _mm_mul_ps(a3, b0));
+    c31 = _mm_add_ps(c31, _mm_mul_ps(a3, b1));
+    a += kGemmMR;
+    b += nr;
+  }
+  _mm_storeu_ps(&acc[0][col], c00);
+  _mm_storeu_ps(&acc[0][col + 4], c01);
+  _mm_storeu_ps(&acc[1][col], c10);
+  _mm_storeu_ps(&acc[1][col + 4], c11);
+  _mm_storeu_ps(&acc[2][col], c20);
+  _mm_storeu_ps(&acc[2][col + 4], c21);
+  _mm_storeu_ps(&acc[3][col], c30);
+  _mm_storeu_ps(&acc[3][col + 4], c31);
+#else
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < kGemmMR; i++) {
+      for (int j = col; j < col + 8; j++) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+    a += kGemmMR;
+    b += nr;
+  }
+#endif
+}
+
+// Computes the full kMR x kPackedNR tile of packed A * packed B into acc
+template <class T>
+using MicroTile = void (*)(int kc, const T* a, const T* b, TileAcc<T>& acc);
+
+// Baseline tiles (SSE2 on x86-64) built from two halves
+void microTileBase(int kc, const double* a, const double* b,
+                   TileAcc<double>& acc) {
+  for (int col = 0; col < kGemmNR; col += 4) {
+    microTile4x4(kc, a, b, col, acc);
+  }
+}
+
+void microTileBase(int kc, const float* a, const float* b,
+                   TileAcc<float>& acc) {
+  for (int col = 0; col < kPackedNR<float>; col += 8) {
+    microTile4x8(kc, a, b, col, acc);
+  }
+}
+
+#ifdef S21_GEMM_AVX2
+// AVX2 + FMA tile: each row of the tile is two 4-wide accumulators
+__attribute__((target("avx2,fma"))) void microTileAvx2(
+    int kc, const double* __restrict a, const double* __restrict b,
+    TileAcc<double>& acc) {
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  for (int p = 0; p < kc; p++) {
+    __m256d b0 = _mm256_load_pd(b);
+    __m256d b1 = _mm256_load_pd(b + 4);
+    __m256d a0 = _mm256_broadcast_sd(a);
+    c00 = _mm256_fmadd_pd(a0, b0, c00);
+    c01 = _mm256_fmadd_pd(a0, b1, c01);
+    __m256d a1 = _mm256_broadcast_sd(a + 1);
+    c10 = _mm256_fmadd_pd(a1, b0, c10);
+    c11 = _mm256_fmadd_pd(a1, b1, c11);
+    __m256d a2 = _mm256_broadcast_sd(a + 2);
+    c20 = _mm256_fmadd_pd(a2, b0, c20);
+    c21 = _mm256_fmadd_pd(a2, b1, c21);
+    __m256d a3 = _mm256_broadcast_sd(a + 3);
+    c30 = _mm256_fmadd_pd(a3, b0, c30);
+    c31 = _mm256_fmadd_pd(a3, b1, c31);
+    a += kGemmMR;
+    b += kGemmNR;
+  }
+  _mm256_storeu_pd(acc[0], c00);
+  _mm256_storeu_pd(acc[0] + 4, c01);
+  _mm256_storeu_pd(acc[1], c10);
+  _mm256_storeu_pd(acc[1] + 4, c11);
+  _mm256_storeu_pd(acc[2], c20);
+  _mm256_storeu_pd(acc[2] + 4, c21);
+  _mm256_storeu_pd(acc[3], c30);
+  _mm256_storeu_pd(acc[3] + 4, c31);
+}
+
+// Float tile: each row is two 8-wide accumulators
+__attribute__((target("avx2,fma"))) void microTileAvx2(
+    int kc, const float* __restrict a, const float* __restrict b,
+    TileAcc<float>& acc) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  for (int p = 0; p < kc; p++) {
+    __m256 b0 = _mm256_load_ps(b);
+    __m256 b1 = _mm256_load_ps(b + 8);
+    __m256 a0 = _mm256_broadcast_ss(a);
+    c00 = _mm256_fmadd_ps(a0, b0, c00);
+    c01 = _mm256_fmadd_ps(a0, b1, c01);
+    __m256 a1 = _mm256_broadcast_ss(a + 1);
+    c10 = _mm256_fmadd_ps(a1, b0, c10);
+    c11 = _mm256_fmadd_ps(a1, b1, c11);
+    __m256 a2 = _mm256_broadcast_ss(a + 2);
+    c20 = _mm256_fmadd_ps(a2, b0, c20);
+    c21 = _mm256_fmadd_ps(a2, b1, c21);
+    __m256 a3 = _mm256_broadcast_ss(a + 3);
+    c30 = _mm256_fmadd_ps(a3, b0, c30);
+    c31 = _mm256_fmadd_ps(a3, b1, c31);
+    a += kGemmMR;
+    b += kPackedNR<float>;
+  }
+  _mm256_storeu_ps(acc[0], c00);
+  _mm256_storeu_ps(acc[0] + 8, c01);
+  _mm256_storeu_ps(acc[1], c10);
+  _mm256_storeu_ps(acc[1] + 8, c11);
+  _mm256_storeu_ps(acc[2], c20);
+  _mm256_storeu_ps(acc[2] + 8, c21);
+  _mm256_storeu_ps(acc[3], c30);
+  _mm256_storeu_ps(acc[3] + 8, c31);
+}
+#endif
+
+// Tile routine for the active SIMD level, AVX2 also needs FMA
+template <class T>
+MicroTile<T> selectMicroTile() {
+#ifdef S21_GEMM_AVX2
+  static const bool fma = __builtin_cpu_supports("fma");
+  if (fma && ActiveSimdLevel() >= SimdLevel::kAvx2) return microTileAvx2;
+#endif
+  return microTileBase;
+}
+
+// Register-tiled kernel: kMR x kPackedNR tile of C += packed A sliver *
+// packed B sliver. Partial edge tiles are accumulated in full and stored
+// masked
+template <class T>
+void microKernel(MicroTile<T> tile, int kc, const T* a, const T* b, T* c,
+                 int ldc, int rows, int cols) {
+  TileAcc<T> acc = {};
+  tile(kc, a, b, acc);
+  for (int i = 0; i < rows; i++) {
+    T* row = c + i * static_cast<std::ptrdiff_t>(ldc);
+    for (int j = 0; j < cols; j++) row[j] += acc[i][j];
+  }
+}
+
+// Plain i-k-j loop for products too small to amortise packing
+template <class T>
+void gemmSmall(int m, int n, int k, const T* a, int rsa, int csa, const T* b,
+               int rsb, int csb, T* c, int ldc, T alpha) {
+  for (int i = 0; i < m; i++) {
+    T* crow = c + i * static_cast<std::ptrdiff_t>(ldc);
+    for (int p = 0; p < k; p++) {
+      T aip = alpha * a[i * static_cast<std::ptrdiff_t>(rsa) +
+                        p * static_cast<std::ptrdiff_t>(csa)];
+      const T* brow = b + p * static_cast<std::ptrdiff_t>(rsb);
+      for (int j = 0; j < n; j++) {
+        crow[j] += aip * brow[j * static_cast<std::ptrdiff_t>(csb)];
+      }
+    }
+  }
+}
+
+// Single-threaded blocked product, C += alpha * A * B
+template <class T>
+void gemmBlocked(int m, int n, int k, const T* a, int rsa, int csa,
+                 const T* b, int rsb, int csb, T* c, int ldc, T alpha) {
+  constexpr int nr = kPackedNR<T>;
+  int ncMax = std::min(kGemmNC, (n + nr - 1) / nr * nr);
+  int kcMax = std::min(kGemmKC, k);
+  T* packedB = packBuffer<T>(static_cast<std::size_t>(kcMax) * ncMax +
+                             static_cast<std::size_t>(kGemmMC) * kcMax);
+  T* packedA = packedB + static_cast<std::size_t>(kcMax) * ncMax;
+  MicroTile<T> tile = selectMicroTile<T>();
+
+  for (int jc = 0; jc < n; jc += kGemmNC) {
+    int nc = std::min(kGemmNC, n - jc);
+    for (int pc = 0; pc < k; pc += kGemmKC) {
+      int kc = std::min(kGemmKC, k - pc);
+      packB(kc, nc,
+            b + pc * static_cast<std::ptrdiff_t>(rsb) +
+                jc * static_cast<std::ptrdiff_t>(csb),
+            rsb, csb, packedB);
+      for (int ic = 0; ic < m; ic += kGemmMC) {
+        int mc = std::min(kGemmMC, m - ic);
+        packA(mc, kc,
+              a + ic * static_cast<std::ptrdiff_t>(rsa) +
+                  pc * static_cast<std::ptrdiff_t>(csa),
+              rsa, csa, alpha, packedA);
+        for (int jr = 0; jr < nc; jr += nr) {
+          for (int ir = 0; ir < mc; ir += kGemmMR) {
+            microKernel(tile, kc, packedA + ir * kc, packedB + jr * kc,
+                        c + (ic + ir) * static_cast<std::ptrdiff_t>(ldc) +
+                            jc + jr,
+                        ldc, std::min(kGemmMR, mc - ir),
+                        std::min(nr, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+// Packed engine shared by double and float: small products skip packing,
+// large ones are split into output tiles across the pool
+template <class T>
+void gemmPacked(int m, int n, int k, const T* a, int rsa, int csa,
+                const T* b, int rsb, int csb, T* c, int ldc, T alpha) {
+  long work = static_cast<long>(m) * n * k;
+  if (work <= kGemmSmall) {
+    gemmSmall(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, alpha);
+    return;
+  }
+  ThreadPool& pool = DefaultThreadPool();
+  int threads = pool.getThreads();
+  if (threads == 1 || work < kGemmParallel) {
+    gemmBlocked(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, alpha);
+    return;
+  }
+
+  // Output tiles of kMC rows, columns split further until there are a few
+  // tiles per thread; every tile packs its own operands
+  constexpr int nr = kPackedNR<T>;
+  int rowTiles = (m + kGemmMC - 1) / kGemmMC;
+  int colTiles = std::max(1, (4 * threads + rowTiles - 1) / rowTiles);
+  int colWidth = (n + colTiles - 1) / colTiles;
+  colWidth = std::max(colWidth, 16 * nr);
+  colWidth = (colWidth + nr - 1) / nr * nr;
+  colTiles = (n + colWidth - 1) / colWidth;
+
+  pool.ParallelFor(rowTiles * colTiles, [=](int tile) {
+    int i0 = tile / colTiles * kGemmMC;
+    int j0 = tile % colTiles * colWidth;
+    gemmBlocked(std::min(kGemmMC, m - i0), std::min(colWidth, n - j0), k,
+                a + i0 * static_cast<std::ptrdiff_t>(rsa), rsa, csa,
+                b + j0 * static_cast<std::ptrdiff_t>(csb), rsb, csb,
+                c + i0 * static_cast<std::ptrdiff_t>(ldc) + j0, ldc, alpha);
+  });
+}
+
+// Rows of C in one task of the portable kernel
+constexpr int kGemmRowTile = 64;
+
+// C += alpha * A * B for the element types without a packed micro kernel:
+// row i of C takes alpha * A(i, p) times row p of the packed panel of B
+template <class T>
+void gemmPortable(int m, int n, int k, const T* a, int rsa, int csa,
+                  const T* b, int rsb, int csb, T* c, int ldc, T alpha) {
+  const auto axpy = SimdFor<T>().axpy;
+  const int ncMax = std::min(kGemmNC, n), kcMax = std::min(kGemmKC, k);
+  ArenaBuffer<T> packed(static_cast<std::size_t>(kcMax) * ncMax);
+  for (int jc = 0; jc < n; jc += kGemmNC) {
+    int nc = std::min(kGemmNC, n - jc);
+    for (int pc = 0; pc < k; pc += kGemmKC) {
+      int kc = std::min(kGemmKC, k - pc);
+      for (int p = 0; p < kc; p++) {
+        const T* from = b + (pc + p) * static_cast<std::ptrdiff_t>(rsb) +
+                        jc * static_cast<std::ptrdiff_t>(csb);
+        T* to = packed.data() + static_cast<std::size_t>(p) * nc;
+        for (int j = 0; j < nc; j++) {
+          to[j] = from[j * static_cast<std::ptrdiff_t>(csb)];
+        }
+      }
+      for (int i = 0; i < m; i++) {
+        const T* arow = a + i * static_cast<std::ptrdiff_t>(rsa) +
+                        pc * static_cast<std::ptrdiff_t>(csa);
+        T* crow = c + i * static_cast<std::ptrdiff_t>(ldc) + jc;
+        for (int p = 0; p < kc; p++) {
+          axpy(crow, packed.data() + static_cast<std::size_t>(p) * nc,
+               alpha * arow[p * static_cast<std::ptrdiff_t>(csa)], nc);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <class T>
+void Gemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb,
+          T* c, int ldc, NonDeduced<T> alpha) {
+  GemmStrided(m, n, k, a, lda, 1, b, ldb, 1, c, ldc, alpha);
+}
+
+template <class T>
+void GemmStrided(int m, int n, int k, const T* a, int rsa, int csa,
+                 const T* b, int rsb, int csb, T* c, int ldc,
+                 NonDeduced<T> alpha) {
+  if (m <= 0 || n <= 0 || k <= 0) return;
+  if constexpr (std::is_same_v<T, float>) {
+    gemmPacked(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, T(alpha));
+    return;
+  }
+  ThreadPool& pool = DefaultThreadPool();
+  long work = static_cast<long>(m) * n * k;
+  int tiles = (m + kGemmRowTile - 1) / kGemmRowTile;
+  if (pool.getThreads() == 1 || work < kGemmParallel || tiles == 1) {
+    gemmPortable(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, alpha);
+    return;
+  }
+  pool.ParallelFor(tiles, [=](int tile) {
+    int i0 = tile * kGemmRowTile;
+    gemmPortable(std::min(kGemmRowTile, m - i0), n, k,
+                 a + i0 * static_cast<std::ptrdiff_t>(rsa), rsa, csa, b, rsb,
+                 csb, c + i0 * static_cast<std::ptrdiff_t>(ldc), ldc, alpha);
+  });
+}
+
+#define S21_GEMM_INSTANTIATE(T)                                           \
+  template void Gemm(int, int, int, const T*, int, const T*, int, T*, int, \
+                     T);                                                   \
+  template void GemmStrided(int, int, int, const T*, int, int, const T*,   \
+                            int, int, T*, int, T);
+
+S21_GEMM_INSTANTIATE(float)
+S21_GEMM_INSTANTIATE(long double)
+S21_GEMM_INSTANTIATE(std::complex<double>)
+
+void Gemm(int m, int n, int k, const double* a, int lda, const double* b,
+          int ldb, double* c, int ldc, double alpha) {
+  GemmStrided(m, n, k, a, lda, 1, b, ldb, 1, c, ldc, alpha);
+}
+
+void GemmStrided(int m, int n, int k, const double* a, int rsa, int csa,
+                 const double* b, int rsb, int csb, double* c, int ldc,
+                 double alpha) {
+  if (m <= 0 || n <= 0 || k <= 0) return;
+  gemmPacked(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, alpha);
+}
+
+}  // namespace s21
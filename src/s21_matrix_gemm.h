@@ -0,0 +1,49 @@
+#ifndef S21_MATRIX_GEMM_H_
+#define S21_MATRIX_GEMM_H_
+
+#include "s21_matrix_scalar.h"
+
+namespace s21 {
+
+// Blocking parameters of the GEMM engine. A kMR x kNR tile of C lives in
+// registers, a kMC x kKC block of A is packed to stay in L2 and a
+// kKC x kNC panel of B is packed to stay in L3
+constexpr int kGemmMR = 4;
+constexpr int kGemmNR = 8;
+constexpr int kGemmMC = 96;
+constexpr int kGemmKC = 256;
+constexpr int kGemmNC = 4096;
+
+// Products with at least this many multiply-adds are split by output tiles
+// across s21::DefaultThreadPool()
+constexpr long kGemmParallel = 128L * 128L * 128L;
+
+// C += alpha * A * B for row-major operands: A is m x k, B is k x n, C is
+// m x n, lda/ldb/ldc are the row strides in elements. C must not alias A or B
+void Gemm(int m, int n, int k, const double* a, int lda, const double* b,
+          int ldb, double* c, int ldc, double alpha = 1.0);
+
+// Same product for operands addressed by a row and a column stride each
+// (element (i, j) of A is a[i * rsa + j * csa]), so transposed or strided
+// views are packed directly instead of being copied first
+void GemmStrided(int m, int n, int k, const double* a, int rsa, int csa,
+                 const double* b, int rsb, int csb, double* c, int ldc,
+                 double alpha = 1.0);
+
+// Same two entry points for float, long double and std::complex<double>
+// elements. float runs the packed engine above with a kGemmMR x 2 * kGemmNR
+// register tile (the same vector registers hold twice the lanes); the other
+// types go through a portable kernel that packs kGemmKC x kGemmNC panels of
+// B into contiguous rows and streams them through SimdFor<T>().axpy.
+// double calls resolve to the functions above
+template <class T>
+void Gemm(int m, int n, int k, const T* a, int lda, const T* b, int ldb,
+          T* c, int ldc, NonDeduced<T> alpha = T(1));
+template <class T>
+void GemmStrided(int m, int n, int k, const T* a, int rsa, int csa,
+                 const T* b, int rsb, int csb, T* c, int ldc,
+                 NonDeduced<T> alpha = T(1));
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,226 @@
+#include "s21_matrix_io.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix_arena.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define S21_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+std::uint32_t swapBytes(std::uint32_t value) {
+  return (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) |
+         (value << 24);
+}
+
+std::uint64_t swapBytes(std::uint64_t value) {
+  return static_cast<std::uint64_t>(
+             swapBytes(static_cast<std::uint32_t>(value)))
+             << 32 |
+         swapBytes(static_cast<std::uint32_t>(value >> 32));
+}
+
+void swapElements(double* values, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    std::uint64_t bits;
+    std::memcpy(&bits, values + i, sizeof(bits));
+    bits = swapBytes(bits);
+    std::memcpy(values + i, &bits, sizeof(bits));
+  }
+}
+
+// Checks a raw header against fileSize and converts its fields to the
+// native byte order; returns true if the payload needs swapping too
+bool parseHeader(FileHeader& header, std::uint64_t fileSize) {
+  if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0) {
+    throw std::invalid_argument("Not a matrix file");
+  }
+  bool swapped = header.byteOrder != kFileByteOrder;
+  if (swapped) {
+    if (swapBytes(header.byteOrder) != kFileByteOrder) {
+      throw std::invalid_argument("Unknown byte order of matrix file");
+    }
+    header.version = swapBytes(header.version);
+    header.dtype = swapBytes(header.dtype);
+    header.payloadOffset = swapBytes(header.payloadOffset);
+    header.rows = static_cast<std::int64_t>(
+        swapBytes(static_cast<std::uint64_t>(header.rows)));
+    header.cols = static_cast<std::int64_t>(
+        swapBytes(static_cast<std::uint64_t>(header.cols)));
+  }
+  if (header.version != kFileVersion || header.dtype != kFileFloat64) {
+    throw std::invalid_argument("Unsupported matrix file format");
+  }
+  if (header.rows <= 0 || header.cols <= 0 || header.rows > INT_MAX ||
+      header.cols > INT_MAX || header.payloadOffset < kFileHeaderSize ||
+      header.payloadOffset % kFileHeaderSize != 0) {
+    throw std::invalid_argument("Wrong parameters for matrix");
+  }
+  // rows * cols * sizeof(double) can wrap, so the element count the file
+  // holds is divided instead
+  if (fileSize < header.payloadOffset ||
+      static_cast<std::uint64_t>(header.rows) >
+          (fileSize - header.payloadOffset) / sizeof(double) /
+              static_cast<std::uint64_t>(header.cols)) {
+    throw std::invalid_argument("Matrix file is truncated");
+  }
+  return swapped;
+}
+
+}  // namespace
+
+void Save(S21ConstMatrixView matrix, const std::string& path) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("Can not open " + path);
+
+  FileHeader header = {};
+  std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+  header.version = kFileVersion;
+  header.dtype = kFileFloat64;
+  header.byteOrder = kFileByteOrder;
+  header.payloadOffset = kFileHeaderSize;
+  header.rows = matrix.getRows();
+  header.cols = matrix.getCols();
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  const int rows = matrix.getRows(), cols = matrix.getCols();
+  const std::streamsize rowBytes =
+      static_cast<std::streamsize>(cols) * sizeof(double);
+  if (matrix.getColStride() == 1 && matrix.getRowStride() == cols) {
+    file.write(reinterpret_cast<const char*>(matrix.getData()),
+               rowBytes * rows);
+  } else if (matrix.isRowMajor()) {
+    for (int i = 0; i < rows; i++) {
+      file.write(reinterpret_cast<const char*>(&matrix(i, 0)), rowBytes);
+    }
+  } else {
+    ArenaBuffer<double> row(static_cast<std::size_t>(cols));
+    for (int i = 0; i < rows; i++) {
+      CopyView(matrix.Row(i), S21MatrixView(row.data(), 1, cols, cols));
+      file.write(reinterpret_cast<const char*>(row.data()), rowBytes);
+    }
+  }
+  if (!file.flush()) throw std::runtime_error("Can not write " + path);
+}
+
+S21Matrix Load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) throw std::runtime_error("Can not open " + path);
+  std::uint64_t fileSize = static_cast<std::uint64_t>(file.tellg());
+  file.seekg(0);
+
+  FileHeader header;
+  if (fileSize < sizeof(header) ||
+      !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    throw std::invalid_argument("Not a matrix file");
+  }
+  bool swapped = parseHeader(header, fileSize);
+
+  S21Matrix result(static_cast<int>(header.rows),
+                   static_cast<int>(header.cols));
+  file.seekg(static_cast<std::streamoff>(header.payloadOffset));
+  file.read(reinterpret_cast<char*>(result.getData()),
+            static_cast<std::streamsize>(result.getSize() * sizeof(double)));
+  if (!file) throw std::runtime_error("Can not read " + path);
+  if (swapped) swapElements(result.getData(), result.getSize());
+  return result;
+}
+
+MappedMatrix::MappedMatrix(const std::string& path) {
+#ifdef S21_HAVE_MMAP
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Can not open " + path);
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Can not stat " + path);
+  }
+  length_ = static_cast<std::size_t>(info.st_size);
+  if (length_ < sizeof(FileHeader)) {
+    ::close(fd);
+    throw std::invalid_argument("Not a matrix file");
+  }
+  void* mapping = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) throw std::runtime_error("Can not map " + path);
+  mapping_ = mapping;
+#else
+  // no mmap: the file is read once into an aligned buffer
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) throw std::runtime_error("Can not open " + path);
+  length_ = static_cast<std::size_t>(file.tellg());
+  if (length_ < sizeof(FileHeader)) {
+    throw std::invalid_argument("Not a matrix file");
+  }
+  mapping_ = AllocateBuffer(length_);
+  file.seekg(0);
+  if (!file.read(static_cast<char*>(mapping_),
+                 static_cast<std::streamsize>(length_))) {
+    unmap();
+    throw std::runtime_error("Can not read " + path);
+  }
+#endif
+
+  FileHeader header;
+  std::memcpy(&header, mapping_, sizeof(header));
+  try {
+    if (parseHeader(header, length_)) {
+      throw std::invalid_argument(
+          "Matrix file has foreign byte order and can not be mapped");
+    }
+  } catch (...) {
+    unmap();
+    throw;
+  }
+  rows_ = static_cast<int>(header.rows);
+  cols_ = static_cast<int>(header.cols);
+  data_ = reinterpret_cast<const double*>(static_cast<const char*>(mapping_) +
+                                          header.payloadOffset);
+}
+
+MappedMatrix::~MappedMatrix() { unmap(); }
+
+MappedMatrix::MappedMatrix(MappedMatrix&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      length_(std::exchange(other.length_, 0)),
+      data_(std::exchange(other.data_, nullptr)),
+      rows_(std::exchange(other.rows_, 0)),
+      cols_(std::exchange(other.cols_, 0)) {}
+
+MappedMatrix& MappedMatrix::operator=(MappedMatrix&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    length_ = std::exchange(other.length_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+    rows_ = std::exchange(other.rows_, 0);
+    cols_ = std::exchange(other.cols_, 0);
+  }
+  return *this;
+}
+
+void MappedMatrix::unmap() {
+  if (!mapping_) return;
+#ifdef S21_HAVE_MMAP
+  ::munmap(mapping_, length_);
+#else
+  FreeBuffer(mapping_);
+#endif
+  mapping_ = nullptr;
+  data_ = nullptr;
+}
+
+}  // namespace s21
@@ -0,0 +1,75 @@
+#ifndef S21_MATRIX_IO_H_
+#define S21_MATRIX_IO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Binary matrix file: a kFileHeaderSize-byte header followed by the
+// elements row after row. The payload starts at a cache-line boundary, so
+// a mapped file can serve as matrix storage as is
+constexpr char kFileMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kFileVersion = 1;
+constexpr std::size_t kFileHeaderSize = 64;
+// Element type codes
+constexpr std::uint32_t kFileFloat64 = 1;
+// Written in the writer's byte order, tells the reader whether to swap
+constexpr std::uint64_t kFileByteOrder = 0x0102030405060708ULL;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t dtype;
+  std::uint64_t byteOrder;
+  std::uint64_t payloadOffset;
+  std::int64_t rows;
+  std::int64_t cols;
+  char reserved[16];
+};
+static_assert(sizeof(FileHeader) == kFileHeaderSize, "fixed header size");
+
+// Writes matrix to path, std::runtime_error if the file can not be written
+void Save(S21ConstMatrixView matrix, const std::string& path);
+
+// Reads a matrix written by Save, swapping bytes if it came from a machine
+// of the other endianness. std::invalid_argument for a malformed file,
+// std::runtime_error if it can not be read
+S21Matrix Load(const std::string& path);
+
+// Read-only matrix backed by the pages of a file written by Save: nothing
+// is read until touched, so opening is instant whatever the size. The
+// elements are consumed through View() by every view kernel, and
+// S21Matrix(mapped.View()) makes a writable copy. Files of the other
+// endianness are rejected, Load them instead
+class MappedMatrix {
+ public:
+  explicit MappedMatrix(const std::string& path);
+  ~MappedMatrix();
+  MappedMatrix(MappedMatrix&& other) noexcept;
+  MappedMatrix& operator=(MappedMatrix&& other) noexcept;
+  MappedMatrix(const MappedMatrix&) = delete;
+  MappedMatrix& operator=(const MappedMatrix&) = delete;
+
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  S21ConstMatrixView View() const {
+    return S21ConstMatrixView(data_, rows_, cols_, cols_);
+  }
+  operator S21ConstMatrixView() const { return View(); }
+
+ private:
+  void unmap();
+
+  void* mapping_ = nullptr;
+  std::size_t length_ = 0;
+  const double* data_ = nullptr;
+  int rows_ = 0, cols_ = 0;
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,188 @@
+#include "s21_matrix_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_simd.h"
+
+namespace s21 {
+
+template <class T>
+int LuFactor(int n, T* a, int lda, int* pivots) {
+  auto row = [a, lda](int i) {
+    return a + i * static_cast<std::ptrdiff_t>(lda);
+  };
+  // the panel and U12 updates are row axpys, run on the SIMD kernels
+  const auto axpy = SimdFor<T>().axpy;
+  int info = 0;
+
+  for (int j0 = 0; j0 < n; j0 += kLuBlock) {
+    int jend = std::min(j0 + kLuBlock, n);
+
+    // unblocked factorization of the panel a[j0:n, j0:jend], row swaps are
+    // applied across the full width
+    for (int j = j0; j < jend; j++) {
+      int pivot = j;
+      RealOf<T> best = std::abs(row(j)[j]);
+      for (int i = j + 1; i < n; i++) {
+        RealOf<T> value = std::abs(row(i)[j]);
+        if (value > best) {
+          best = value;
+          pivot = i;
+        }
+      }
+      pivots[j] = pivot;
+      if (pivot != j) std::swap_ranges(row(j), row(j) + n, row(pivot));
+      if (best == 0) {
+        if (info == 0) info = j + 1;
+        continue;
+      }
+
+      const T* rj = row(j);
+      T inv = T(1) / rj[j];
+      for (int i = j + 1; i < n; i++) {
+        T* ri = row(i);
+        T l = ri[j] *= inv;
+        axpy(ri + j + 1, rj + j + 1, -l, jend - j - 1);
+      }
+    }
+
+    if (jend == n) break;
+
+    // U12 = L11^-1 * A12
+    for (int i = j0 + 1; i < jend; i++) {
+      T* ri = row(i);
+      for (int k = j0; k < i; k++) {
+        axpy(ri + jend, row(k) + jend, -ri[k], n - jend);
+      }
+    }
+
+    // A22 -= L21 * U12
+    Gemm(n - jend, n - jend, jend - j0, row(jend) + j0, lda, row(j0) + jend,
+         lda, row(jend) + jend, lda, T(-1));
+  }
+  return info;
+}
+
+template <class T>
+void LuSolve(int n, int nrhs, const T* lu, int lda, const int* pivots, T* b,
+             int ldb) {
+  auto luRow = [lu, lda](int i) {
+    return lu + i * static_cast<std::ptrdiff_t>(lda);
+  };
+  auto row = [b, ldb](int i) {
+    return b + i * static_cast<std::ptrdiff_t>(ldb);
+  };
+
+  for (int i = 0; i < n; i++) {
+    if (pivots[i] != i) std::swap_ranges(row(i), row(i) + nrhs, row(pivots[i]));
+  }
+
+  // forward substitution with the unit lower triangle, block rows first
+  // take the contribution of everything above them through Gemm
+  for (int i0 = 0; i0 < n; i0 += kLuBlock) {
+    int i1 = std::min(i0 + kLuBlock, n);
+    Gemm(i1 - i0, nrhs, i0, luRow(i0), lda, row(0), ldb, row(i0), ldb, T(-1));
+    for (int i = i0 + 1; i < i1; i++) {
+      T* xi = row(i);
+      for (int k = i0; k < i; k++) {
+        T l = luRow(i)[k];
+        const T* xk = row(k);
+        for (int c = 0; c < nrhs; c++) xi[c] -= l * xk[c];
+      }
+    }
+  }
+
+  // back substitution with the upper triangle, bottom block first
+  for (int i0 = (n - 1) / kLuBlock * kLuBlock; i0 >= 0; i0 -= kLuBlock) {
+    int i1 = std::min(i0 + kLuBlock, n);
+    Gemm(i1 - i0, nrhs, n - i1, luRow(i0) + i1, lda, row(i1), ldb, row(i0),
+         ldb, T(-1));
+    for (int i = i1 - 1; i >= i0; i--) {
+      T* xi = row(i);
+      for (int k = i + 1; k < i1; k++) {
+        T u = luRow(i)[k];
+        const T* xk = row(k);
+        for (int c = 0; c < nrhs; c++) xi[c] -= u * xk[c];
+      }
+      T inv = T(1) / luRow(i)[i];
+      for (int c = 0; c < nrhs; c++) xi[c] *= inv;
+    }
+  }
+}
+
+template <class T>
+T LuDeterminant(int n, const T* lu, int lda, const int* pivots) {
+  T result = 1;
+  for (int i = 0; i < n; i++) {
+    result *= lu[i * static_cast<std::ptrdiff_t>(lda) + i];
+    if (pivots[i] != i) result = -result;
+  }
+  return result;
+}
+
+template <class T>
+RealOf<T> MaxAbs(int rows, int cols, const T* a, int lda) {
+  RealOf<T> result = 0;
+  for (int i = 0; i < rows; i++) {
+    const T* row = a + i * static_cast<std::ptrdiff_t>(lda);
+    for (int j = 0; j < cols; j++) result = std::max(result, std::abs(row[j]));
+  }
+  return result;
+}
+
+template <class T>
+void RowColumnMax(int n, const T* a, int lda, RealOf<T>* rowMax,
+                  RealOf<T>* colMax) {
+  std::fill_n(colMax, n, RealOf<T>(0));
+  for (int i = 0; i < n; i++) {
+    const T* row = a + i * static_cast<std::ptrdiff_t>(lda);
+    rowMax[i] = 0;
+    for (int j = 0; j < n; j++) {
+      RealOf<T> value = std::abs(row[j]);
+      rowMax[i] = std::max(rowMax[i], value);
+      colMax[j] = std::max(colMax[j], value);
+    }
+  }
+}
+
+template <class T>
+bool LuSingular(int n, const T* lu, int lda, const int* pivots,
+                const RealOf<T>* rowMax, const RealOf<T>* colMax) {
+  // order[k] is the original row that ended up at position k
+  std::vector<int> order(n);
+  for (int i = 0; i < n; i++) order[i] = i;
+  for (int i = 0; i < n; i++) std::swap(order[i], order[pivots[i]]);
+  const RealOf<T> epsilon = n * std::numeric_limits<RealOf<T>>::epsilon();
+  for (int k = 0; k < n; k++) {
+    RealOf<T> pivot = std::abs(lu[k * static_cast<std::ptrdiff_t>(lda) + k]);
+    RealOf<T> scale = std::min(rowMax[order[k]], colMax[k]);
+    if (!(pivot > epsilon * scale &&
+          pivot <= std::numeric_limits<RealOf<T>>::max())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#define S21_LU_INSTANTIATE(T)                                        \
+  template int LuFactor(int, T*, int, int*);                         \
+  template void LuSolve(int, int, const T*, int, const int*, T*, int); \
+  template T LuDeterminant(int, const T*, int, const int*);          \
+  template RealOf<T> MaxAbs(int, int, const T*, int);                \
+  template void RowColumnMax(int, const T*, int, RealOf<T>*, RealOf<T>*); \
+  template bool LuSingular(int, const T*, int, const int*,             \
+                           const RealOf<T>*, const RealOf<T>*);
+
+S21_LU_INSTANTIATE(float)
+S21_LU_INSTANTIATE(double)
+S21_LU_INSTANTIATE(long double)
+S21_LU_INSTANTIATE(std::complex<double>)
+
+}  // namespace s21
@@ -0,0 +1,53 @@
+#ifndef S21_MATRIX_LU_H_
+#define S21_MATRIX_LU_H_
+
+#include "s21_matrix_scalar.h"
+
+namespace s21 {
+
+// All routines are instantiated for the matrix element types (see
+// s21_matrix_scalar.h); complex pivots are chosen by modulus
+
+// Panel width of the blocked LU factorization
+constexpr int kLuBlock = 64;
+
+// In-place LU factorization with partial pivoting of the n x n row-major
+// matrix a (row stride lda): on return the strict lower triangle holds L
+// (unit diagonal implied) and the upper triangle holds U, and row i was
+// exchanged with row pivots[i] at step i. Returns 0, or k + 1 if U(k, k)
+// is exactly zero (the factorization is still completed)
+template <class T>
+int LuFactor(int n, T* a, int lda, int* pivots);
+
+// Solves A * X = B in place for the n x nrhs row-major block b (row stride
+// ldb), given the output of LuFactor for A. U must be non-singular
+template <class T>
+void LuSolve(int n, int nrhs, const T* lu, int lda, const int* pivots, T* b,
+             int ldb);
+
+// Signed determinant of A from the output of LuFactor
+template <class T>
+T LuDeterminant(int n, const T* lu, int lda, const int* pivots);
+
+// Largest magnitude in the rows x cols matrix a
+template <class T>
+RealOf<T> MaxAbs(int rows, int cols, const T* a, int lda);
+
+// Largest magnitude in each row (rowMax) and each column (colMax) of the
+// n x n matrix a, the scales LuSingular measures pivots against
+template <class T>
+void RowColumnMax(int n, const T* a, int lda, RealOf<T>* rowMax,
+                  RealOf<T>* colMax);
+
+// True if some pivot of the factorization is not finite or vanishes to
+// working precision against its own row and column of A: |u_kk| <= n * eps
+// * min(rowMax, colMax), taken for the row that was moved to position k.
+// Only cancellation makes a pivot that small, so regular matrices whose
+// rows or columns differ widely in scale are not reported
+template <class T>
+bool LuSingular(int n, const T* lu, int lda, const int* pivots,
+                const RealOf<T>* rowMax, const RealOf<T>* colMax);
+
+}  // namespace s21
+
+#endif
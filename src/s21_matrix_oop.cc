@@ -1,17 +1,93 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "s21_cholesky_solver.h"
+#include "s21_lu_solver.h"
+#include "s21_matrix_arena.h"
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_strassen.h"
+#include "s21_matrix_transpose.h"
+
+namespace {
+
+// EqMatrix tolerance, float only resolves about 7 significant digits
+template <class T>
+constexpr double kTolerance = std::is_same_v<T, float> ? 1e-5 : 1e-7;
+
+// Product of two views: the kernel packs each operand from its strides, a
+// transposed operand costs no extra copy
+template <class T>
+S21BasicMatrix<T> multiplyViews(S21BasicMatrixView<const T> left,
+                                S21BasicMatrixView<const T> right) {
+  if (left.getCols() != right.getRows()) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  S21BasicMatrix<T> result(left.getRows(), right.getCols());
+  s21::GemmView(result.View(), left, right);
+  return result;
+}
+
+}  // namespace
+
+// Factors of the elements as they were at `version`, with the determinant
+// and inverse derived from them once asked for. A Hermitian matrix is
+// first tried with Cholesky, anything else (or a failed attempt) uses LU
+template <class T>
+struct S21BasicMatrix<T>::Factorization {
+  Factorization(ConstMatrixView matrix, std::uint64_t version)
+      : version(version) {
+    const int n = matrix.getRows();
+    if (s21::SpdDetection() &&
+        s21::IsHermitian(n, matrix.getData(), matrix.getRowStride())) {
+      cholesky.emplace(matrix);
+      if (cholesky->isPositiveDefinite()) return;
+      cholesky.reset();
+    }
+    lu.emplace(matrix);
+  }
+
+  bool isSingular() const {
+    return cholesky ? cholesky->isSingular() : lu->isSingular();
+  }
+  T Determinant() const {
+    return cholesky ? cholesky->Determinant() : lu->Determinant();
+  }
+  S21BasicMatrix InverseMatrix() const {
+    return cholesky ? cholesky->InverseMatrix() : lu->InverseMatrix();
+  }
+
+  std::optional<S21BasicCholeskySolver<T>> cholesky;
+  std::optional<S21BasicLuSolver<T>> lu;
+  std::uint64_t version;
+  std::optional<T> determinant;
+  std::optional<S21BasicMatrix> inverse;
+};
+
 // Default Constructor
-S21Matrix::S21Matrix() : rows_(5), cols_(5) { memAlloc(rows_, cols_); }
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix() : rows_(5), cols_(5) {
+  memAlloc(rows_, cols_);
+}
 
 // Destructor
-S21Matrix::~S21Matrix() {
+template <class T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
   if (matrix_) {
     memFree();
   }
 }
 
 // Parametrized constructor
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols) {
   if (rows_ <= 0 || cols_ <= 0) {
     throw std::invalid_argument("Wrong parameters for matrix");
   } else {
@@ -20,167 +96,232 @@ S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
 }
 
 // Copy contructor
-S21Matrix::S21Matrix(const S21Matrix& other)
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
     : rows_(other.getRows()), cols_(other.getCols()) {
-  matrix_ = new double*[rows_];
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_];
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
-  }
+  memAlloc(rows_, cols_);
+  std::copy_n(other.matrix_, getSize(), matrix_);
 }
 
-// Move constructor
-S21Matrix::S21Matrix(S21Matrix&& other)
-    : rows_(other.getRows()), cols_(other.getCols()) {
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    resizeMatrix(rows_, cols_, other.rows_, other.cols_);
-  } else {
-    matrix_ = new double*[rows_];
-    for (int i = 0; i < rows_; i++) {
-      matrix_[i] = new double[cols_];
-      for (int j = 0; j < cols_; j++) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
-    }
-  }
+// Move constructor, takes over the buffer of other and leaves it empty
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      matrix_(other.matrix_),
+      version_(other.version_),
+      cache_(std::move(other.cache_)) {
+  other.rows_ = 0;
+  other.cols_ = 0;
   other.matrix_ = nullptr;
+  other.touch();
+}
+
+// Materialization of a view
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(ConstMatrixView view)
+    : S21BasicMatrix(view.getRows(), view.getCols()) {
+  s21::CopyView(view, View());
+}
+
+// Materialization of a minor's submatrix
+template <class T>
+S21BasicMatrix<T>::S21BasicMatrix(ConstMinorView minor)
+    : S21BasicMatrix(minor.getRows(), minor.getCols()) {
+  s21::CopyView(minor, View());
 }
 
 // are matrices equal
-bool S21Matrix::EqMatrix(const S21Matrix& other) {
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     return false;
   } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        if (std::abs(matrix_[i][j] - other.matrix_[i][j]) > 1e-7) return false;
-      }
-    }
+    return s21::SimdFor<T>().equal(matrix_, other.matrix_, getSize(),
+                                     kTolerance<T>);
   }
-  return true;
 }
 
 // sum of two matrices
-void S21Matrix::SumMatrix(const S21Matrix& other) {
+template <class T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Different matrix dimensions");
   } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        matrix_[i][j] += other.matrix_[i][j];
-      }
-    }
+    touch();
+    s21::SimdFor<T>().add(matrix_, matrix_, other.matrix_, getSize());
   }
 }
 
 // difference between two matrices
-void S21Matrix::SubMatrix(const S21Matrix& other) {
+template <class T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Different matrix dimensions");
   } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        matrix_[i][j] -= other.matrix_[i][j];
-      }
-    }
+    touch();
+    s21::SimdFor<T>().sub(matrix_, matrix_, other.matrix_, getSize());
   }
 }
 
+// comparison with a view
+template <class T>
+bool S21BasicMatrix<T>::EqMatrix(ConstMatrixView other) const {
+  return s21::EqualViews(View(), other, kTolerance<T>);
+}
+
+// sum with a view
+template <class T>
+void S21BasicMatrix<T>::SumMatrix(ConstMatrixView other) {
+  s21::AddView(View(), other);
+}
+
+// difference with a view
+template <class T>
+void S21BasicMatrix<T>::SubMatrix(ConstMatrixView other) {
+  s21::SubView(View(), other);
+}
+
 // multiply by a number
-void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] *= num;
-    }
-  }
+template <class T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  touch();
+  s21::SimdFor<T>().scale(matrix_, matrix_, num, getSize());
 }
 
 // multiply two matrices
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  if (cols_ != other.rows_) {
-    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
-  } else {
-    S21Matrix result(rows_, other.cols_);
-    for (int i = 0; i < result.rows_; i++) {
-      for (int j = 0; j < result.cols_; j++) {
-        double sum = 0.0;
-        for (int k = 0; k < cols_; k++) {
-          sum += matrix_[i][k] * other.matrix_[k][j];
-        }
-        result.matrix_[i][j] = sum;
-      }
-    }
-    if (matrix_) memFree();
-    rows_ = result.rows_;
-    cols_ = result.cols_;
-    memAlloc(rows_, cols_);
-    *this = result;
-  }
+template <class T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  S21BasicMatrix result = *this * other;
+  swap(result);
+}
+
+// multiply by a view, the product is written to a new buffer anyway
+template <class T>
+void S21BasicMatrix<T>::MulMatrix(ConstMatrixView other) {
+  S21BasicMatrix result = View() * other;
+  swap(result);
 }
 
 // trunspose matrix
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix result(cols_, rows_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      result.matrix_[j][i] = matrix_[i][j];
-    }
-  }
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() {
+  S21BasicMatrix result(cols_, rows_);
+  s21::TransposeCopy(rows_, cols_, matrix_, stride_, result.matrix_,
+                     result.stride_);
   return result;
 }
 
-// count matrix determinant
-double S21Matrix::Determinant() {
+// transpose matrix without a second buffer
+template <class T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  touch();
+  if (rows_ == cols_) {
+    s21::TransposeSquare(rows_, matrix_, stride_);
+  } else {
+    s21::TransposeCycles(rows_, cols_, matrix_);
+    std::swap(rows_, cols_);
+    stride_ = cols_;
+  }
+}
+
+// count matrix determinant: closed forms up to 3x3, pivoted LU above
+template <class T>
+T S21BasicMatrix<T>::Determinant() {
   if (rows_ != cols_) {
     throw std::invalid_argument("Matrix is not square");
   }
+  const T* m = matrix_;
+  const int s = stride_;
   if (rows_ == 1) {
-    return matrix_[0][0];
+    return m[0];
   } else if (rows_ == 2) {
-    return matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
+    return m[0] * m[s + 1] - m[1] * m[s];
+  } else if (rows_ == 3) {
+    return m[0] * (m[s + 1] * m[2 * s + 2] - m[s + 2] * m[2 * s + 1]) -
+           m[1] * (m[s] * m[2 * s + 2] - m[s + 2] * m[2 * s]) +
+           m[2] * (m[s] * m[2 * s + 1] - m[s + 1] * m[2 * s]);
   } else {
-    double result = 0;
-    for (int i = 0; i < cols_; ++i) {
-      double subres = 0;
-      S21Matrix minor = cut_matrix(0, i);
-      subres = minor.Determinant();
-      result += matrix_[0][i] * subres * pow(-1, i);
-    }
-    return result;
+    Factorization& cached = factorization();
+    if (!cached.determinant) cached.determinant = cached.Determinant();
+    return *cached.determinant;
   }
 }
 
-// count the algebraic addition matrix of the current one
-S21Matrix S21Matrix::CalcComplements() {
+// factors of the current elements, refactored only after a change
+template <class T>
+typename S21BasicMatrix<T>::Factorization& S21BasicMatrix<T>::factorization() {
+  if (!cache_ || cache_->version != version_) {
+    cache_ = std::make_unique<Factorization>(constView(), version_);
+  }
+  return *cache_;
+}
+
+// count the algebraic addition matrix of the current one. For a
+// non-singular matrix it is det(A) * (A^-1)^T from a single factorization,
+// otherwise every minor is factored in one reused scratch buffer
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
   if (rows_ != cols_) {
     throw std::invalid_argument("Matrix is not square");
   }
 
-  S21Matrix result(rows_, cols_);
-  for (int x_row = 0; x_row < rows_; x_row++) {
-    for (int x_col = 0; x_col < cols_; x_col++) {
-      S21Matrix minor_A = cut_matrix(x_row, x_col);
-      result.matrix_[x_row][x_col] =
-          minor_A.Determinant() * pow(-1, x_row + x_col);
+  const int n = rows_;
+  S21BasicMatrix result(n, n);
+  if (n == 1) {
+    result.matrix_[0] = 1;
+    return result;
+  }
+
+  Factorization& cached = factorization();
+  if (!cached.isSingular()) {
+    if (!cached.determinant) cached.determinant = cached.Determinant();
+    if (!cached.inverse) cached.inverse = cached.InverseMatrix();
+    T det = *cached.determinant;
+    result = *cached.inverse;
+    const std::ptrdiff_t stride = result.stride_;
+    for (int i = 0; i < n; i++) {
+      T* row = result.matrix_ + i * stride;
+      row[i] *= det;
+      for (int j = i + 1; j < n; j++) {
+        T& mirror = result.matrix_[j * stride + i];
+        T upper = row[j];
+        row[j] = det * mirror;
+        mirror = det * upper;
+      }
     }
+    return result;
   }
 
-  *this = result;
+  // rank-deficient input: the scratch of lu is reused for each minor
+  S21BasicMatrix lu(n - 1, n - 1);
+  s21::ArenaBuffer<int> pivots(n - 1);
+  for (int x_row = 0; x_row < n; x_row++) {
+    for (int x_col = 0; x_col < n; x_col++) {
+      s21::CopyView(ConstMinorView(constView(), x_row, x_col), lu.View());
+      s21::LuFactor(n - 1, lu.matrix_, lu.stride_, pivots.data());
+      T minor =
+          s21::LuDeterminant(n - 1, lu.matrix_, lu.stride_, pivots.data());
+      result.matrix_[x_row * static_cast<std::ptrdiff_t>(result.stride_) +
+                     x_col] =
+          (x_row + x_col) % 2 ? -minor : minor;
+    }
+  }
   return result;
 }
 
 // calculates inverse matrix
-S21Matrix S21Matrix::InverseMatrix() {
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
   if (rows_ != cols_) {
     throw std::invalid_argument("Matrix is not square");
   }
 
   if (rows_ == 1) {
-    if (matrix_[0][0] != 0) {
-      S21Matrix result(1, 1);
-      result.matrix_[0][0] = 1 / matrix_[0][0];
+    if (matrix_[0] != T(0)) {
+      S21BasicMatrix result(1, 1);
+      result.matrix_[0] = T(1) / matrix_[0];
       return result;
     } else {
       throw std::invalid_argument(
@@ -188,122 +329,230 @@ S21Matrix S21Matrix::InverseMatrix() {
     }
   }
 
-  double res_determinant = this->Determinant();
-  if (res_determinant == 0) {
-    throw std::invalid_argument("Matrix determinant is 0.");
+  // throws "Matrix determinant is 0." for a singular matrix
+  Factorization& cached = factorization();
+  if (!cached.inverse) cached.inverse = cached.InverseMatrix();
+  return *cached.inverse;
+}
+
+// solves this * X = b
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(ConstMatrixView b) const {
+  return S21BasicLuSolver<T>(View()).Solve(b);
+}
+
+// + operator overloading
+template <class T>
+S21BasicMatrix<T>
+S21BasicMatrix<T>::operator+(const S21BasicMatrix& other) const& {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Different matrix dimensions");
   }
+  S21BasicMatrix result(rows_, cols_);
+  s21::SimdFor<T>().add(result.matrix_, matrix_, other.matrix_, getSize());
+  return result;
+}
 
-  S21Matrix cofactor = this->CalcComplements();
-  S21Matrix inverse = cofactor.Transpose();
-  inverse.MulNumber(1 / res_determinant);
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator+(const S21BasicMatrix& other) && {
+  SumMatrix(other);
+  return std::move(*this);
+}
 
-  return inverse;
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator+(S21BasicMatrix&& other) const& {
+  other.SumMatrix(*this);
+  return std::move(other);
 }
 
-// + operator overloading
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
-  S21Matrix temp(*this);
-  temp.SumMatrix(other);
-  return temp;
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator+(S21BasicMatrix&& other) && {
+  SumMatrix(other);
+  return std::move(*this);
 }
 
 // - operator overloading
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
-  S21Matrix temp(*this);
-  temp.SubMatrix(other);
-  return temp;
+template <class T>
+S21BasicMatrix<T>
+S21BasicMatrix<T>::operator-(const S21BasicMatrix& other) const& {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Different matrix dimensions");
+  }
+  S21BasicMatrix result(rows_, cols_);
+  s21::SimdFor<T>().sub(result.matrix_, matrix_, other.matrix_, getSize());
+  return result;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator-(const S21BasicMatrix& other) && {
+  SubMatrix(other);
+  return std::move(*this);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator-(S21BasicMatrix&& other) const& {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Different matrix dimensions");
+  }
+  other.touch();
+  s21::SimdFor<T>().sub(other.matrix_, matrix_, other.matrix_, getSize());
+  return std::move(other);
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator-(S21BasicMatrix&& other) && {
+  SubMatrix(other);
+  return std::move(*this);
 }
 
-// * operator overloading
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix temp(*this);
-  temp.MulMatrix(other);
-  return temp;
+// * operator overloading, the product goes straight into the result;
+// large products take the Strassen path once it is enabled
+template <class T>
+S21BasicMatrix<T>
+S21BasicMatrix<T>::operator*(const S21BasicMatrix& other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  S21BasicMatrix result(rows_, other.cols_);
+  if constexpr (std::is_same_v<T, double>) {
+    int crossover = s21::StrassenCrossover();
+    if (crossover > 0 && std::min({rows_, cols_, other.cols_}) >= crossover) {
+      s21::Strassen(rows_, other.cols_, cols_, matrix_, stride_,
+                    other.matrix_, other.stride_, result.matrix_,
+                    result.stride_, crossover);
+      return result;
+    }
+  }
+  s21::Gemm(rows_, other.cols_, cols_, matrix_, stride_, other.matrix_,
+            other.stride_, result.matrix_, result.stride_);
+  return result;
 }
 
+
 // * num operator overloading
-S21Matrix S21Matrix::operator*(const double num) {
-  S21Matrix temp(*this);
-  temp.MulNumber(num);
-  return temp;
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(const T num) const& {
+  S21BasicMatrix result(rows_, cols_);
+  s21::SimdFor<T>().scale(result.matrix_, matrix_, num, getSize());
+  return result;
+}
+
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(const T num) && {
+  MulNumber(num);
+  return std::move(*this);
 }
 
 // == operator overloading
-bool S21Matrix::operator==(const S21Matrix& other) {
+template <class T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) {
   return this->EqMatrix(other);
 }
 
 // = operator overloading
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
   if (this != &other) {
-    if (rows_ != other.rows_ || cols_ != other.cols_) {
-      resizeMatrix(rows_, cols_, other.rows_, other.cols_);
+    touch();
+    if (rows_ != other.rows_ || cols_ != other.cols_ || !matrix_) {
+      memFree();
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      memAlloc(rows_, cols_);
     }
 
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
-    }
+    std::copy_n(other.matrix_, getSize(), matrix_);
+  }
+  return *this;
+}
+
+// = operator overloading for expiring matrices, takes over their buffer
+template <class T>
+S21BasicMatrix<T>&
+S21BasicMatrix<T>::operator=(S21BasicMatrix&& other) noexcept {
+  if (this != &other) {
+    memFree();
+    swap(other);
   }
   return *this;
 }
 
 // += operator overloading
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
   this->SumMatrix(other);
   return (*this);
 }
 
 // -= operator overloading
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
   this->SubMatrix(other);
   return (*this);
 }
 
 // *= operator overloading
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
   this->MulMatrix(other);
   return (*this);
 }
 
 // *= number operator overloading
-S21Matrix& S21Matrix::operator*=(const double num) {
+template <class T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const T num) {
   this->MulNumber(num);
   return (*this);
 }
 
 // (int i, int j) operator overloading
-double& S21Matrix::operator()(int row, int col) & {
+template <class T>
+T& S21BasicMatrix<T>::operator()(int row, int col) & {
+  touch();
   if (row < 0 || col < 0) {
     throw std::invalid_argument("Zero or negative parameters for matrix");
   } else {
     if (row >= rows_ || col >= cols_) {
       throw std::invalid_argument("There are no such parameters for matrix");
     } else {
-      return matrix_[row][col];
+      return matrix_[row * static_cast<std::ptrdiff_t>(stride_) + col];
     }
   }
 }
 
-// Allocation of memory for the matrix
-void S21Matrix::memAlloc(int rows, int cols) {
-  matrix_ = new double*[rows];
-  for (int i = 0; i < rows; i++) {
-    matrix_[i] = new double[cols];
-    for (int j = 0; j < cols; j++) {
-      matrix_[i][j] = 0;
-    }
-  }
+// Allocation of a zero-filled, kAlignment-aligned buffer of count elements,
+// recycled through the current s21::Arena if the caller installed one
+template <class T>
+T* S21BasicMatrix<T>::allocBuffer(std::size_t count) {
+  static_assert(kAlignment == s21::kArenaAlignment, "arena alignment");
+  T* buffer =
+      static_cast<T*>(s21::AllocateBuffer(s21::BufferBytes(count, sizeof(T))));
+  std::fill_n(buffer, count, T(0));
+  return buffer;
+}
+
+// Release of a buffer obtained from allocBuffer
+template <class T>
+void S21BasicMatrix<T>::freeBuffer(T* buffer) {
+  s21::FreeBuffer(buffer);
+}
+
+// Allocation of memory for the matrix (one block for all rows)
+template <class T>
+void S21BasicMatrix<T>::memAlloc(int rows, int cols) {
+  touch();
+  stride_ = cols;
+  matrix_ = allocBuffer(static_cast<std::size_t>(rows) * stride_);
 }
 
 // Method to deallocate memory for the matrix
-void S21Matrix::memFree() {
+template <class T>
+void S21BasicMatrix<T>::memFree() {
+  touch();
+  // the factors and inverse describe the buffer that is going away
+  cache_.reset();
   if (matrix_) {
-    for (int i = 0; i < rows_; i++) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
+    freeBuffer(matrix_);
     rows_ = 0;
     cols_ = 0;
     matrix_ = nullptr;
@@ -311,78 +560,86 @@ void S21Matrix::memFree() {
 }
 
 // Setting random values for matrix
-void S21Matrix::setValue() {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = (float)(rand()) / (float)(RAND_MAX);
-    }
+template <class T>
+void S21BasicMatrix<T>::setValue() {
+  touch();
+  for (std::size_t i = 0, size = getSize(); i < size; i++) {
+    matrix_[i] = static_cast<T>((float)(rand()) / (float)(RAND_MAX));
   }
 }
 
-// Resizing matrix
-void S21Matrix::resizeMatrix(int oldRows, int oldCols, int newRows,
-                             int newCols) {
-  double** newMatrix = new double*[newRows];
-  for (int i = 0; i < newRows; i++) {
-    newMatrix[i] = new double[newCols];
-  }
-
-  for (int i = 0; i < std::min(oldRows, newRows); i++) {
-    for (int j = 0; j < std::min(oldCols, newCols); j++) {
-      newMatrix[i][j] = matrix_[i][j];
-    }
+// Resizing matrix, the overlapping block is kept and the rest is zero
+template <class T>
+void S21BasicMatrix<T>::resizeMatrix(int oldRows, int oldCols, int newRows,
+                                     int newCols) {
+  if (newRows <= 0 || newCols <= 0) {
+    throw std::invalid_argument("Wrong parameters for matrix");
   }
-
-  if (newRows > oldRows || newCols > oldCols) {
-    for (int i = oldRows; i < newRows; i++) {
-      for (int j = 0; j < newCols; j++) {
-        newMatrix[i][j] = 0.0;
-      }
+  touch();
+  T* newMatrix = allocBuffer(static_cast<std::size_t>(newRows) * newCols);
+  if (matrix_) {
+    for (int i = 0; i < std::min(oldRows, newRows); i++) {
+      std::copy_n(matrix_ + i * static_cast<std::ptrdiff_t>(stride_),
+                  std::min(oldCols, newCols),
+                  newMatrix + i * static_cast<std::ptrdiff_t>(newCols));
     }
+    freeBuffer(matrix_);
   }
 
-  // for (int i = 0; i < oldRows; i++) {
-  //   delete[] matrix_[i];
-  // }
-  // delete[] matrix_;
-
   matrix_ = newMatrix;
   rows_ = newRows;
   cols_ = newCols;
+  stride_ = newCols;
 }
 
-void S21Matrix::setGivenValues(double* values, int numValues) {
-  if (numValues != rows_ * cols_) {
+// Exchange of contents with another matrix without copying elements
+template <class T>
+void S21BasicMatrix<T>::swap(S21BasicMatrix& other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(stride_, other.stride_);
+  std::swap(matrix_, other.matrix_);
+  // a cached factorization follows the buffer it describes
+  std::swap(version_, other.version_);
+  std::swap(cache_, other.cache_);
+}
+
+template <class T>
+void S21BasicMatrix<T>::setGivenValues(T* values, int numValues) {
+  if (numValues < 0 || static_cast<std::size_t>(numValues) != getSize()) {
     throw std::invalid_argument(
         "Number of values does not match the matrix size");
   }
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = values[i * cols_ + j];
-    }
-  }
+  touch();
+  std::copy_n(values, numValues, matrix_);
 }
 
-S21Matrix S21Matrix::cut_matrix(int ban_row, int ban_col) {
-  S21Matrix result(rows_ - 1, cols_ - 1);
+// copy of the matrix without one row and one column
+template <class T>
+S21BasicMatrix<T> S21BasicMatrix<T>::cut_matrix(int ban_row, int ban_col) {
+  return S21BasicMatrix(ConstMinorView(constView(), ban_row, ban_col));
+}
 
-  int row_to_skip = 0;
-  int col_to_skip = 0;
+S21Matrix operator*(S21ConstMatrixView left, S21ConstMatrixView right) {
+  return multiplyViews(left, right);
+}
 
-  for (int row = 0; row < rows_; row++) {
-    if (row != ban_row) {
-      col_to_skip = 0;
-      for (int col = 0; col < cols_; col++) {
-        if (col != ban_col) {
-          result.matrix_[row - row_to_skip][col - col_to_skip] =
-              matrix_[row][col];
-        } else {
-          col_to_skip = 1;
-        }
-      }
-    } else {
-      row_to_skip = 1;
-    }
-  }
-  return result;
-}
\ No newline at end of file
+S21FloatMatrix operator*(S21FloatMatrix::ConstMatrixView left,
+                         S21FloatMatrix::ConstMatrixView right) {
+  return multiplyViews(left, right);
+}
+
+S21LongDoubleMatrix operator*(S21LongDoubleMatrix::ConstMatrixView left,
+                              S21LongDoubleMatrix::ConstMatrixView right) {
+  return multiplyViews(left, right);
+}
+
+S21ComplexMatrix operator*(S21ComplexMatrix::ConstMatrixView left,
+                           S21ComplexMatrix::ConstMatrixView right) {
+  return multiplyViews(left, right);
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+template class S21BasicMatrix<std::complex<double>>;
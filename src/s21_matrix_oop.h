@@ -3,65 +3,245 @@
 
 #include <algorithm>
 #include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <new>
+
+#include "s21_matrix_scalar.h"
+#include "s21_matrix_view.h"
+
+namespace s21 {
+template <class E>
+class MatrixExpr;
+}  // namespace s21
+
+// Dense matrix of T elements, instantiated for float, double, long double
+// and std::complex<double>; S21Matrix is the double one. Every element type
+// runs the same algorithms, double keeps the tuned kernels (packed GEMM,
+// Strassen) and float runs the element-wise ones at twice the SIMD width
+template <class T>
+class S21BasicMatrix {
+ public:
+  using Scalar = T;
+  using MatrixView = S21BasicMatrixView<T>;
+  using ConstMatrixView = S21BasicMatrixView<const T>;
+  using MinorView = S21BasicMinorView<T>;
+  using ConstMinorView = S21BasicMinorView<const T>;
+
+  // Alignment of the element buffer in bytes (one cache line)
+  static constexpr std::size_t kAlignment = 64;
+
+  // Row-pointer facade over the contiguous buffer, keeps `getMatrix()[i][j]`
+  // working for callers written against the old `double**` layout
+  template <class U>
+  class BasicRowAccessor {
+   public:
+    BasicRowAccessor(U* data, int stride) : data_(data), stride_(stride) {}
+    U* operator[](int row) const {
+      return data_ + static_cast<std::ptrdiff_t>(row) * stride_;
+    }
+    bool operator==(std::nullptr_t) const { return data_ == nullptr; }
+    bool operator!=(std::nullptr_t) const { return data_ != nullptr; }
+
+   private:
+    U* data_;
+    int stride_;
+  };
+  using RowAccessor = BasicRowAccessor<T>;
+  using ConstRowAccessor = BasicRowAccessor<const T>;
 
-class S21Matrix {
  private:
   // Attributes (implement the access to private fields `rows_` and `cols_`
   // via accessor and mutator. If the matrix increases in size, it is filled
   // with zeros. If it decreases in size, the excess is simply discarded)
   int rows_, cols_;  // Rows and columns
-  double** matrix_;  // Pointer to the memory where the matrix is allocated
+  int stride_;       // Distance in elements between the starts of two rows
+  T* matrix_;        // Row-major, kAlignment-aligned contiguous buffer
+  // Bumped by every path that may change the elements: mutating operations,
+  // resizes, assignments and each hand-out of mutable access (operator(),
+  // getData(), getMatrix(), views)
+  std::uint64_t version_ = 0;
+  // Cholesky (for Hermitian positive-definite elements, see
+  // s21::SetSpdDetection) or LU factorization, determinant and inverse of
+  // the elements as of cache_->version, built on demand by Determinant(),
+  // InverseMatrix() and CalcComplements() and reused while the version is
+  // unchanged
+  struct Factorization;
+  std::unique_ptr<Factorization> cache_;
+
+  void touch() { version_++; }
+  Factorization& factorization();
+  ConstMatrixView constView() const {
+    return ConstMatrixView(matrix_, rows_, cols_, stride_);
+  }
+  static T* allocBuffer(std::size_t count);
+  static void freeBuffer(T* buffer);
 
  public:
-  S21Matrix();   // Default constructor
-  ~S21Matrix();  // Destructor
-  S21Matrix(
+  S21BasicMatrix();   // Default constructor
+  ~S21BasicMatrix();  // Destructor
+  S21BasicMatrix(
       int rows,
       int cols);  // Parametrized constructor with number of rows and columns
-  S21Matrix(const S21Matrix& other);  // Copy constructor
-  S21Matrix(S21Matrix&& other);       // Move constructor
+  S21BasicMatrix(const S21BasicMatrix& other);      // Copy constructor
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;  // Move constructor
+  // Element type conversion, e.g. a float copy of a double matrix;
+  // complex matrices do not convert to real ones
+  template <class U>
+  explicit S21BasicMatrix(const S21BasicMatrix<U>& other)
+      : S21BasicMatrix(other.getRows(), other.getCols()) {
+    for (int i = 0; i < rows_; i++) {
+      const U* from = other.getMatrix()[i];
+      T* to = matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+      for (int j = 0; j < cols_; j++) {
+        to[j] = s21::ConvertScalar<T>(from[j]);
+      }
+    }
+  }
+  // Evaluation of a lazy expression (defined in s21_matrix_expr.h)
+  template <class E>
+  S21BasicMatrix(const s21::MatrixExpr<E>& expr);
+  // Owning copy of the elements a view looks at
+  explicit S21BasicMatrix(ConstMatrixView view);
+  // Owning copy of a minor's submatrix
+  explicit S21BasicMatrix(ConstMinorView minor);
 
   // accessors
   int getRows() const { return rows_; }
   int getCols() const { return cols_; }
-  double** getMatrix() const { return matrix_; }
+  int getStride() const { return stride_; }
+  // Mutable access counts as a change: results cached before it are
+  // dropped. A pointer or view kept across a Determinant() or
+  // InverseMatrix() call must be taken again before writing through it
+  RowAccessor getMatrix() {
+    touch();
+    return RowAccessor(matrix_, stride_);
+  }
+  ConstRowAccessor getMatrix() const {
+    return ConstRowAccessor(matrix_, stride_);
+  }
+  T* getData() {
+    touch();
+    return matrix_;
+  }
+  const T* getData() const { return matrix_; }
+  // Number of elements
+  std::size_t getSize() const {
+    return static_cast<std::size_t>(rows_) * cols_;
+  }
+
+  // Non-owning views of the elements, valid until the buffer is
+  // reallocated; TransposeView reads the transpose without copying
+  MatrixView View() {
+    touch();
+    return MatrixView(matrix_, rows_, cols_, stride_);
+  }
+  ConstMatrixView View() const { return constView(); }
+  ConstMatrixView TransposeView() const { return View().Transposed(); }
+  operator ConstMatrixView() const { return View(); }
+  // Zero-copy blocks, rows, columns and minors (one row and one column
+  // left out); writes through a mutable one land in this matrix, taking
+  // one counts as a change like View()
+  MatrixView Block(int row, int col, int rows, int cols) {
+    return View().Block(row, col, rows, cols);
+  }
+  ConstMatrixView Block(int row, int col, int rows, int cols) const {
+    return View().Block(row, col, rows, cols);
+  }
+  MatrixView Row(int row) { return View().Row(row); }
+  ConstMatrixView Row(int row) const { return View().Row(row); }
+  MatrixView Col(int col) { return View().Col(col); }
+  ConstMatrixView Col(int col) const { return View().Col(col); }
+  MinorView Minor(int banRow, int banCol) {
+    return MinorView(View(), banRow, banCol);
+  }
+  ConstMinorView Minor(int banRow, int banCol) const {
+    return ConstMinorView(View(), banRow, banCol);
+  }
 
   // mutators
-  void setRows(int rows) { rows_ = rows; }
-  void setCols(int cols) { cols_ = cols; }
-
-  // matrix operations
-  bool EqMatrix(const S21Matrix& other);
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
+  void setRows(int rows) { resizeMatrix(rows_, cols_, rows, cols_); }
+  void setCols(int cols) { resizeMatrix(rows_, cols_, rows_, cols); }
+
+  // matrix operations (EqMatrix allows 1e-7, or 1e-5 for float elements)
+  bool EqMatrix(const S21BasicMatrix& other);
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicMatrix& other);
+  // Same operations with an operand read through a view
+  bool EqMatrix(ConstMatrixView other) const;
+  void SumMatrix(ConstMatrixView other);
+  void SubMatrix(ConstMatrixView other);
+  void MulMatrix(ConstMatrixView other);
+  S21BasicMatrix Transpose();
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements();
+  // Determinant() and InverseMatrix() of an unchanged matrix reuse the
+  // cached factorization: a repeated Determinant() is O(1), a repeated
+  // InverseMatrix() costs one copy of the cached inverse
+  T Determinant();
+  S21BasicMatrix InverseMatrix();
+  // X with this * X = b, by one LU factorization; S21BasicLuSolver keeps
+  // the factorization for further right-hand sides
+  S21BasicMatrix Solve(ConstMatrixView b) const;
 
   // operators overload
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(const double num);
-  bool operator==(const S21Matrix& other);
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(const double num);
-  double& operator()(int row, int col) &;
+  // (an expiring operand lends its buffer to the result)
+  S21BasicMatrix operator+(const S21BasicMatrix& other) const&;
+  S21BasicMatrix operator+(const S21BasicMatrix& other) &&;
+  S21BasicMatrix operator+(S21BasicMatrix&& other) const&;
+  S21BasicMatrix operator+(S21BasicMatrix&& other) &&;
+  S21BasicMatrix operator-(const S21BasicMatrix& other) const&;
+  S21BasicMatrix operator-(const S21BasicMatrix& other) &&;
+  S21BasicMatrix operator-(S21BasicMatrix&& other) const&;
+  S21BasicMatrix operator-(S21BasicMatrix&& other) &&;
+  S21BasicMatrix operator*(const S21BasicMatrix& other) const;
+  S21BasicMatrix operator*(const T num) const&;
+  S21BasicMatrix operator*(const T num) &&;
+  bool operator==(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+  template <class E>
+  S21BasicMatrix& operator=(const s21::MatrixExpr<E>& expr);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const T num);
+  T& operator()(int row, int col) &;
 
   // helpers
   void memAlloc(int rows, int cols);
   void memFree();
   void setValue();
   void resizeMatrix(int oldRows, int oldCols, int newRows, int newCols);
-  void setGivenValues(double* values, int numValues);
-  S21Matrix cut_matrix(int ban_row, int ban_col);
+  void setGivenValues(T* values, int numValues);
+  void swap(S21BasicMatrix& other) noexcept;
+  S21BasicMatrix cut_matrix(int ban_row, int ban_col);
 };
 
+using S21Matrix = S21BasicMatrix<double>;
+using S21FloatMatrix = S21BasicMatrix<float>;
+using S21LongDoubleMatrix = S21BasicMatrix<long double>;
+using S21ComplexMatrix = S21BasicMatrix<std::complex<double>>;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+extern template class S21BasicMatrix<std::complex<double>>;
+
+// Product of two views, each operand is packed straight from its strides;
+// one overload per element type, so either side may be a matrix or a
+// mutable view
+S21Matrix operator*(S21ConstMatrixView left, S21ConstMatrixView right);
+S21FloatMatrix operator*(S21FloatMatrix::ConstMatrixView left,
+                         S21FloatMatrix::ConstMatrixView right);
+S21LongDoubleMatrix operator*(S21LongDoubleMatrix::ConstMatrixView left,
+                              S21LongDoubleMatrix::ConstMatrixView right);
+S21ComplexMatrix operator*(S21ComplexMatrix::ConstMatrixView left,
+                           S21ComplexMatrix::ConstMatrixView right);
+
 #endif
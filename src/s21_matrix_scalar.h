@@ -0,0 +1,61 @@
+#ifndef S21_MATRIX_SCALAR_H_
+#define S21_MATRIX_SCALAR_H_
+
+#include <cmath>
+#include <complex>
+#include <type_traits>
+
+namespace s21 {
+
+// Element types the matrix templates are instantiated for: float, double,
+// long double and std::complex<double>
+
+template <class T>
+struct IsComplex : std::false_type {};
+template <class T>
+struct IsComplex<std::complex<T>> : std::true_type {};
+template <class T>
+constexpr bool kIsComplex = IsComplex<T>::value;
+
+// Type of |x| for an element x: the element type itself, or the component
+// type of a complex one
+template <class T>
+using RealOf = decltype(std::abs(T()));
+
+// T unchanged, but kept out of template argument deduction, so that a
+// parameter of this type converts instead of clashing with the one T is
+// deduced from
+template <class T>
+struct TypeIdentity {
+  using type = T;
+};
+template <class T>
+using NonDeduced = typename TypeIdentity<T>::type;
+
+// Element conversion behind the converting matrix constructors; a complex
+// value has no real counterpart, so that direction does not compile
+template <class To, class From>
+To ConvertScalar(const From& value) {
+  static_assert(kIsComplex<To> || !kIsComplex<From>,
+                "complex elements do not convert to real ones");
+  if constexpr (kIsComplex<To> && !kIsComplex<From>) {
+    return To(static_cast<typename To::value_type>(value));
+  } else {
+    return static_cast<To>(value);
+  }
+}
+
+// Complex conjugate that keeps a real element real (std::conj of a real
+// number returns a complex one)
+template <class T>
+T Conj(const T& value) {
+  if constexpr (kIsComplex<T>) {
+    return std::conj(value);
+  } else {
+    return value;
+  }
+}
+
+}  // namespace s21
+
+#endif
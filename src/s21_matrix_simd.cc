@@ -0,0 +1,499 @@
+#include "s21_matrix_simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+// Portable fallback, also used for the tails of the vector kernels and as
+// the only kernels of long double and complex elements
+
+template <class T>
+void addScalar(T* dst, const T* a, const T* b, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) dst[i] = a[i] + b[i];
+}
+
+template <class T>
+void subScalar(T* dst, const T* a, const T* b, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) dst[i] = a[i] - b[i];
+}
+
+template <class T>
+void scaleScalar(T* dst, const T* src, T num, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) dst[i] = src[i] * num;
+}
+
+template <class T>
+void axpyScalar(T* dst, const T* src, T num, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) dst[i] += num * src[i];
+}
+
+template <class T>
+bool equalScalar(const T* a, const T* b, std::size_t n, double tolerance) {
+  for (std::size_t i = 0; i < n; i++) {
+    if (std::abs(a[i] - b[i]) > tolerance) return false;
+  }
+  return true;
+}
+
+#ifdef S21_SIMD_X86
+
+// SSE2, two doubles per register
+
+void addSse2(double* dst, const double* a, const double* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  addScalar(dst + i, a + i, b + i, n - i);
+}
+
+void subSse2(double* dst, const double* a, const double* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  subScalar(dst + i, a + i, b + i, n - i);
+}
+
+void scaleSse2(double* dst, const double* src, double num, std::size_t n) {
+  __m128d factor = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(src + i), factor));
+  }
+  scaleScalar(dst + i, src + i, num, n - i);
+}
+
+void axpySse2(double* dst, const double* src, double num, std::size_t n) {
+  __m128d factor = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d product = _mm_mul_pd(_mm_loadu_pd(src + i), factor);
+    _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), product));
+  }
+  axpyScalar(dst + i, src + i, num, n - i);
+}
+
+bool equalSse2(const double* a, const double* b, std::size_t n,
+               double tolerance) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d limit = _mm_set1_pd(tolerance);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128d d0 = _mm_andnot_pd(
+        sign, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    __m128d d1 = _mm_andnot_pd(
+        sign, _mm_sub_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    __m128d miss =
+        _mm_or_pd(_mm_cmpgt_pd(d0, limit), _mm_cmpgt_pd(d1, limit));
+    if (_mm_movemask_pd(miss)) return false;
+  }
+  return equalScalar(a + i, b + i, n - i, tolerance);
+}
+
+// AVX2, four doubles per register, two registers per iteration
+
+__attribute__((target("avx2"))) void addAvx2(double* dst, const double* a,
+                                             const double* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d s0 = _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+    __m256d s1 =
+        _mm256_add_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+    _mm256_storeu_pd(dst + i, s0);
+    _mm256_storeu_pd(dst + i + 4, s1);
+  }
+  addScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void subAvx2(double* dst, const double* a,
+                                             const double* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d s0 = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+    __m256d s1 =
+        _mm256_sub_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+    _mm256_storeu_pd(dst + i, s0);
+    _mm256_storeu_pd(dst + i + 4, s1);
+  }
+  subScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void scaleAvx2(double* dst, const double* src,
+                                               double num, std::size_t n) {
+  __m256d factor = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d s0 = _mm256_mul_pd(_mm256_loadu_pd(src + i), factor);
+    __m256d s1 = _mm256_mul_pd(_mm256_loadu_pd(src + i + 4), factor);
+    _mm256_storeu_pd(dst + i, s0);
+    _mm256_storeu_pd(dst + i + 4, s1);
+  }
+  scaleScalar(dst + i, src + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) void axpyAvx2(double* dst, const double* src,
+                                              double num, std::size_t n) {
+  __m256d factor = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d p0 = _mm256_mul_pd(_mm256_loadu_pd(src + i), factor);
+    __m256d p1 = _mm256_mul_pd(_mm256_loadu_pd(src + i + 4), factor);
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i), p0));
+    _mm256_storeu_pd(dst + i + 4,
+                     _mm256_add_pd(_mm256_loadu_pd(dst + i + 4), p1));
+  }
+  axpyScalar(dst + i, src + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) bool equalAvx2(const double* a,
+                                               const double* b, std::size_t n,
+                                               double tolerance) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d limit = _mm256_set1_pd(tolerance);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d d0 = _mm256_andnot_pd(
+        sign, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    __m256d d1 = _mm256_andnot_pd(
+        sign,
+        _mm256_sub_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    __m256d miss = _mm256_or_pd(_mm256_cmp_pd(d0, limit, _CMP_GT_OQ),
+                                _mm256_cmp_pd(d1, limit, _CMP_GT_OQ));
+    if (_mm256_movemask_pd(miss)) return false;
+  }
+  return equalScalar(a + i, b + i, n - i, tolerance);
+}
+
+// AVX-512, eight doubles per register, tails through masked loads
+
+__attribute__((target("avx512f"))) void addAvx512(double* dst, const double* a,
+                                                  const double* b,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(
+        dst + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+    _mm512_mask_storeu_pd(dst + i, mask,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(mask, a + i),
+                                        _mm512_maskz_loadu_pd(mask, b + i)));
+  }
+}
+
+__attribute__((target("avx512f"))) void subAvx512(double* dst, const double* a,
+                                                  const double* b,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(
+        dst + i, _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+    _mm512_mask_storeu_pd(dst + i, mask,
+                          _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a + i),
+                                        _mm512_maskz_loadu_pd(mask, b + i)));
+  }
+}
+
+__attribute__((target("avx512f"))) void scaleAvx512(double* dst,
+                                                    const double* src,
+                                                    double num, std::size_t n) {
+  __m512d factor = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(src + i), factor));
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+    _mm512_mask_storeu_pd(
+        dst + i, mask,
+        _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, src + i), factor));
+  }
+}
+
+__attribute__((target("avx512f"))) void axpyAvx512(double* dst,
+                                                   const double* src,
+                                                   double num, std::size_t n) {
+  __m512d factor = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d product = _mm512_mul_pd(_mm512_loadu_pd(src + i), factor);
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i), product));
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+    __m512d product =
+        _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, src + i), factor);
+    _mm512_mask_storeu_pd(
+        dst + i, mask,
+        _mm512_add_pd(_mm512_maskz_loadu_pd(mask, dst + i), product));
+  }
+}
+
+__attribute__((target("avx512f"))) bool equalAvx512(const double* a,
+                                                    const double* b,
+                                                    std::size_t n,
+                                                    double tolerance) {
+  const __m512d limit = _mm512_set1_pd(tolerance);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d d = _mm512_abs_pd(
+        _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+    if (_mm512_cmp_pd_mask(d, limit, _CMP_GT_OQ)) return false;
+  }
+  if (i < n) {
+    __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+    __m512d left = _mm512_maskz_loadu_pd(mask, a + i);
+    __m512d right = _mm512_maskz_loadu_pd(mask, b + i);
+    __m512d d = _mm512_abs_pd(_mm512_sub_pd(left, right));
+    if (_mm512_cmp_pd_mask(d, limit, _CMP_GT_OQ)) return false;
+  }
+  return true;
+}
+
+// float kernels: twice the elements per register of the double ones
+
+void addSse2(float* dst, const float* a, const float* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  addScalar(dst + i, a + i, b + i, n - i);
+}
+
+void subSse2(float* dst, const float* a, const float* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i,
+                  _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  subScalar(dst + i, a + i, b + i, n - i);
+}
+
+void scaleSse2(float* dst, const float* src, float num, std::size_t n) {
+  __m128 factor = _mm_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), factor));
+  }
+  scaleScalar(dst + i, src + i, num, n - i);
+}
+
+void axpySse2(float* dst, const float* src, float num, std::size_t n) {
+  __m128 factor = _mm_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 product = _mm_mul_ps(_mm_loadu_ps(src + i), factor);
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), product));
+  }
+  axpyScalar(dst + i, src + i, num, n - i);
+}
+
+bool equalSse2(const float* a, const float* b, std::size_t n,
+               double tolerance) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 limit = _mm_set1_ps(static_cast<float>(tolerance));
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 d = _mm_andnot_ps(
+        sign, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    if (_mm_movemask_ps(_mm_cmpgt_ps(d, limit))) return false;
+  }
+  return equalScalar(a + i, b + i, n - i, tolerance);
+}
+
+__attribute__((target("avx2"))) void addAvx2(float* dst, const float* a,
+                                             const float* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 s0 = _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    __m256 s1 =
+        _mm256_add_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+    _mm256_storeu_ps(dst + i, s0);
+    _mm256_storeu_ps(dst + i + 8, s1);
+  }
+  addScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void subAvx2(float* dst, const float* a,
+                                             const float* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 s0 = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    __m256 s1 =
+        _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+    _mm256_storeu_ps(dst + i, s0);
+    _mm256_storeu_ps(dst + i + 8, s1);
+  }
+  subScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void scaleAvx2(float* dst, const float* src,
+                                               float num, std::size_t n) {
+  __m256 factor = _mm256_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 s0 = _mm256_mul_ps(_mm256_loadu_ps(src + i), factor);
+    __m256 s1 = _mm256_mul_ps(_mm256_loadu_ps(src + i + 8), factor);
+    _mm256_storeu_ps(dst + i, s0);
+    _mm256_storeu_ps(dst + i + 8, s1);
+  }
+  scaleScalar(dst + i, src + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) void axpyAvx2(float* dst, const float* src,
+                                              float num, std::size_t n) {
+  __m256 factor = _mm256_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 p0 = _mm256_mul_ps(_mm256_loadu_ps(src + i), factor);
+    __m256 p1 = _mm256_mul_ps(_mm256_loadu_ps(src + i + 8), factor);
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), p0));
+    _mm256_storeu_ps(dst + i + 8,
+                     _mm256_add_ps(_mm256_loadu_ps(dst + i + 8), p1));
+  }
+  axpyScalar(dst + i, src + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) bool equalAvx2(const float* a, const float* b,
+                                               std::size_t n,
+                                               double tolerance) {
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 limit = _mm256_set1_ps(static_cast<float>(tolerance));
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 d0 = _mm256_andnot_ps(
+        sign, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    __m256 d1 = _mm256_andnot_ps(
+        sign,
+        _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    __m256 miss = _mm256_or_ps(_mm256_cmp_ps(d0, limit, _CMP_GT_OQ),
+                               _mm256_cmp_ps(d1, limit, _CMP_GT_OQ));
+    if (_mm256_movemask_ps(miss)) return false;
+  }
+  return equalScalar(a + i, b + i, n - i, tolerance);
+}
+
+#endif
+
+template <class T>
+const BasicSimdKernels<T> kScalarKernels = {addScalar<T>, subScalar<T>,
+                                           scaleScalar<T>, axpyScalar<T>,
+                                           equalScalar<T>};
+#ifdef S21_SIMD_X86
+const SimdKernels kSse2Kernels = {addSse2, subSse2, scaleSse2, axpySse2,
+                                  equalSse2};
+const SimdKernels kAvx2Kernels = {addAvx2, subAvx2, scaleAvx2, axpyAvx2,
+                                  equalAvx2};
+const SimdKernels kAvx512Kernels = {addAvx512, subAvx512, scaleAvx512,
+                                    axpyAvx512, equalAvx512};
+const BasicSimdKernels<float> kSse2FloatKernels = {addSse2, subSse2, scaleSse2,
+                                                   axpySse2, equalSse2};
+const BasicSimdKernels<float> kAvx2FloatKernels = {addAvx2, subAvx2, scaleAvx2,
+                                                   axpyAvx2, equalAvx2};
+#endif
+
+const SimdKernels* kernelsFor(SimdLevel level) {
+  switch (level) {
+#ifdef S21_SIMD_X86
+    case SimdLevel::kAvx512:
+      return &kAvx512Kernels;
+    case SimdLevel::kAvx2:
+      return &kAvx2Kernels;
+    case SimdLevel::kSse2:
+      return &kSse2Kernels;
+#endif
+    default:
+      return &kScalarKernels<double>;
+  }
+}
+
+const BasicSimdKernels<float>* floatKernelsFor(SimdLevel level) {
+  switch (level) {
+#ifdef S21_SIMD_X86
+    case SimdLevel::kAvx512:
+    case SimdLevel::kAvx2:
+      return &kAvx2FloatKernels;
+    case SimdLevel::kSse2:
+      return &kSse2FloatKernels;
+#endif
+    default:
+      return &kScalarKernels<float>;
+  }
+}
+
+struct ActiveKernels {
+  std::atomic<SimdLevel> level{DetectedSimdLevel()};
+  std::atomic<const SimdKernels*> kernels{kernelsFor(level)};
+  std::atomic<const BasicSimdKernels<float>*> floatKernels{
+      floatKernelsFor(level)};
+};
+
+ActiveKernels& active() {
+  static ActiveKernels instance;
+  return instance;
+}
+
+}  // namespace
+
+SimdLevel DetectedSimdLevel() {
+  static const SimdLevel detected = [] {
+#ifdef S21_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::kAvx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::kAvx2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::kSse2;
+#endif
+    return SimdLevel::kScalar;
+  }();
+  return detected;
+}
+
+SimdLevel ActiveSimdLevel() { return active().level; }
+
+void SetSimdLevel(SimdLevel level) {
+  level = std::min(level, DetectedSimdLevel());
+  active().level = level;
+  active().kernels = kernelsFor(level);
+  active().floatKernels = floatKernelsFor(level);
+}
+
+const SimdKernels& Simd() { return *active().kernels; }
+
+template <>
+const BasicSimdKernels<float>& SimdFor<float>() {
+  return *active().floatKernels;
+}
+
+template <>
+const BasicSimdKernels<double>& SimdFor<double>() {
+  return Simd();
+}
+
+template <>
+const BasicSimdKernels<long double>& SimdFor<long double>() {
+  return kScalarKernels<long double>;
+}
+
+template <>
+const BasicSimdKernels<std::complex<double>>& SimdFor<std::complex<double>>() {
+  return kScalarKernels<std::complex<double>>;
+}
+
+}  // namespace s21
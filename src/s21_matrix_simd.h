@@ -0,0 +1,55 @@
+#ifndef S21_MATRIX_SIMD_H_
+#define S21_MATRIX_SIMD_H_
+
+#include <complex>
+#include <cstddef>
+
+namespace s21 {
+
+// Instruction set levels the element-wise kernels are compiled for
+enum class SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+// Element-wise kernels over n contiguous elements, dst may alias a or src
+template <class T>
+struct BasicSimdKernels {
+  void (*add)(T* dst, const T* a, const T* b, std::size_t n);
+  void (*sub)(T* dst, const T* a, const T* b, std::size_t n);
+  void (*scale)(T* dst, const T* src, T num, std::size_t n);
+  // dst += num * src
+  void (*axpy)(T* dst, const T* src, T num, std::size_t n);
+  // true if |a[i] - b[i]| <= tolerance for every i, stops at the first miss
+  bool (*equal)(const T* a, const T* b, std::size_t n, double tolerance);
+};
+
+using SimdKernels = BasicSimdKernels<double>;
+
+// Best level supported by this CPU and OS, queried through CPUID once
+SimdLevel DetectedSimdLevel();
+
+// Level the kernels currently run at (DetectedSimdLevel() by default)
+SimdLevel ActiveSimdLevel();
+
+// Forces a level, clamped to DetectedSimdLevel(); meant for tests and
+// benchmarks, not safe to call while other threads use the kernels
+void SetSimdLevel(SimdLevel level);
+
+// Kernels for ActiveSimdLevel()
+const SimdKernels& Simd();
+
+// Kernels for element type T at ActiveSimdLevel(): double is Simd(), float
+// has vector kernels of its own (AVX2 at most), long double and
+// std::complex<double> run portable loops
+template <class T>
+const BasicSimdKernels<T>& SimdFor();
+template <>
+const BasicSimdKernels<float>& SimdFor<float>();
+template <>
+const BasicSimdKernels<double>& SimdFor<double>();
+template <>
+const BasicSimdKernels<long double>& SimdFor<long double>();
+template <>
+const BasicSimdKernels<std::complex<double>>& SimdFor<std::complex<double>>();
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,147 @@
+#include "s21_matrix_strassen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#include "s21_matrix_arena.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_simd.h"
+
+namespace s21 {
+
+namespace {
+
+std::atomic<int> strassenCrossover{0};
+
+bool isLeaf(int m, int n, int k, int crossover) {
+  return std::min({m, n, k}) < std::max(crossover, 2);
+}
+
+double* at(double* p, int row, int ld) {
+  return p + row * static_cast<std::ptrdiff_t>(ld);
+}
+
+const double* at(const double* p, int row, int ld) {
+  return p + row * static_cast<std::ptrdiff_t>(ld);
+}
+
+void zero(int rows, int cols, double* c, int ldc) {
+  for (int i = 0; i < rows; i++) std::fill_n(at(c, i, ldc), cols, 0.0);
+}
+
+// c = a + b, row by row through the SIMD kernels; c may alias a or b
+void add(int rows, int cols, const double* a, int lda, const double* b,
+         int ldb, double* c, int ldc) {
+  const auto kernel = Simd().add;
+  for (int i = 0; i < rows; i++) {
+    kernel(at(c, i, ldc), at(a, i, lda), at(b, i, ldb), cols);
+  }
+}
+
+// c = a - b
+void sub(int rows, int cols, const double* a, int lda, const double* b,
+         int ldb, double* c, int ldc) {
+  const auto kernel = Simd().sub;
+  for (int i = 0; i < rows; i++) {
+    kernel(at(c, i, ldc), at(a, i, lda), at(b, i, ldb), cols);
+  }
+}
+
+// One level of the Winograd variant with the two-temporary schedule of
+// Douglas et al.: X holds m/2 x max(k/2, n/2), Y holds k/2 x n/2, and the
+// quadrants of C keep the partial sums. Deeper levels reuse the space past
+// X and Y, so the workspace is one slab for the whole recursion
+void strassen(int m, int n, int k, const double* a, int lda, const double* b,
+              int ldb, double* c, int ldc, int crossover, double* work) {
+  if (isLeaf(m, n, k, crossover)) {
+    zero(m, n, c, ldc);
+    Gemm(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+  const int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  const double *a11 = a, *a12 = a + k2, *a21 = at(a, m2, lda), *a22 = a21 + k2;
+  const double *b11 = b, *b12 = b + n2, *b21 = at(b, k2, ldb), *b22 = b21 + n2;
+  double *c11 = c, *c12 = c + n2, *c21 = at(c, m2, ldc), *c22 = c21 + n2;
+  const int ldx = std::max(k2, n2);
+  double* x = work;
+  double* y = x + static_cast<std::size_t>(m2) * ldx;
+  double* deeper = y + static_cast<std::size_t>(k2) * n2;
+  auto product = [&](const double* p, int ldp, const double* q, int ldq,
+                     double* r, int ldr) {
+    strassen(m2, n2, k2, p, ldp, q, ldq, r, ldr, crossover, deeper);
+  };
+
+  sub(m2, k2, a11, lda, a21, lda, x, ldx);      // S3 = A11 - A21
+  sub(k2, n2, b22, ldb, b12, ldb, y, n2);       // T3 = B22 - B12
+  product(x, ldx, y, n2, c21, ldc);             // P7 = S3 T3
+  add(m2, k2, a21, lda, a22, lda, x, ldx);      // S1 = A21 + A22
+  sub(k2, n2, b12, ldb, b11, ldb, y, n2);       // T1 = B12 - B11
+  product(x, ldx, y, n2, c22, ldc);             // P5 = S1 T1
+  sub(m2, k2, x, ldx, a11, lda, x, ldx);        // S2 = S1 - A11
+  sub(k2, n2, b22, ldb, y, n2, y, n2);          // T2 = B22 - T1
+  product(x, ldx, y, n2, c12, ldc);             // P6 = S2 T2
+  sub(m2, k2, a12, lda, x, ldx, x, ldx);        // S4 = A12 - S2
+  product(x, ldx, b22, ldb, c11, ldc);          // P3 = S4 B22
+  product(a11, lda, b11, ldb, x, ldx);          // P1 = A11 B11
+  add(m2, n2, x, ldx, c12, ldc, c12, ldc);      // U2 = P1 + P6
+  add(m2, n2, c12, ldc, c21, ldc, c21, ldc);    // U3 = U2 + P7
+  add(m2, n2, c12, ldc, c22, ldc, c12, ldc);    // U4 = U2 + P5
+  add(m2, n2, c21, ldc, c22, ldc, c22, ldc);    // C22 = U3 + P5
+  add(m2, n2, c12, ldc, c11, ldc, c12, ldc);    // C12 = U4 + P3
+  sub(k2, n2, y, n2, b21, ldb, y, n2);          // T4 = T2 - B21
+  product(a22, lda, y, n2, c11, ldc);           // P4 = A22 T4
+  sub(m2, n2, c21, ldc, c11, ldc, c21, ldc);    // C21 = U3 - P4
+  product(a12, lda, b21, ldb, c11, ldc);        // P2 = A12 B21
+  add(m2, n2, x, ldx, c11, ldc, c11, ldc);      // C11 = P1 + P2
+
+  // peeling: the even part is done, the odd row, column and inner index
+  // are thin products the classical kernel handles well
+  const int me = 2 * m2, ne = 2 * n2, ke = 2 * k2;
+  if (ke < k) {
+    Gemm(me, ne, 1, a + ke, lda, at(b, ke, ldb), ldb, c, ldc);
+  }
+  if (ne < n) {
+    zero(m, 1, c + ne, ldc);
+    Gemm(m, 1, k, a, lda, b + ne, ldb, c + ne, ldc);
+  }
+  if (me < m) {
+    zero(1, ne, at(c, me, ldc), ldc);
+    Gemm(1, ne, k, at(a, me, lda), lda, b, ldb, at(c, me, ldc), ldc);
+  }
+}
+
+}  // namespace
+
+std::size_t StrassenWorkspace(int m, int n, int k, int crossover) {
+  std::size_t total = 0;
+  while (!isLeaf(m, n, k, crossover)) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    total += static_cast<std::size_t>(m) * std::max(k, n) +
+             static_cast<std::size_t>(k) * n;
+  }
+  return total;
+}
+
+void Strassen(int m, int n, int k, const double* a, int lda, const double* b,
+              int ldb, double* c, int ldc, int crossover) {
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0) {
+    zero(m, n, c, ldc);
+    return;
+  }
+  ArenaBuffer<double> work(StrassenWorkspace(m, n, k, crossover));
+  strassen(m, n, k, a, lda, b, ldb, c, ldc, crossover, work.data());
+}
+
+int StrassenCrossover() {
+  return strassenCrossover.load(std::memory_order_relaxed);
+}
+
+void SetStrassenCrossover(int crossover) {
+  strassenCrossover.store(std::max(crossover, 0), std::memory_order_relaxed);
+}
+
+}  // namespace s21
@@ -0,0 +1,37 @@
+#ifndef S21_MATRIX_STRASSEN_H_
+#define S21_MATRIX_STRASSEN_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+// Smallest dimension from which a Strassen level pays off against Gemm on
+// a typical AVX2 machine, used when the path is enabled without a size
+constexpr int kStrassenCrossover = 512;
+
+// C = A * B for row-major operands (A is m x k, B is k x n, C is m x n,
+// lda/ldb/ldc are the row strides) by the Strassen-Winograd recursion: 7
+// half-size products and 15 additions per level. Products whose smallest
+// dimension is below crossover go to Gemm, odd dimensions are peeled off
+// and fixed up with thin Gemm calls. The temporaries of all levels come
+// from one buffer of StrassenWorkspace() doubles taken from the arena
+// once. C must not alias A or B; it is overwritten, not accumulated into
+void Strassen(int m, int n, int k, const double* a, int lda, const double* b,
+              int ldb, double* c, int ldc,
+              int crossover = kStrassenCrossover);
+
+// Doubles of workspace Strassen() needs for these dimensions
+std::size_t StrassenWorkspace(int m, int n, int k,
+                              int crossover = kStrassenCrossover);
+
+// Crossover S21Matrix products use: products of matrices whose every
+// dimension is at least this go through Strassen(). 0 (the default) keeps
+// every product on the classical kernel, whose rounding errors are smaller
+int StrassenCrossover();
+
+// Enables the Strassen path from the given size, 0 disables it
+void SetStrassenCrossover(int crossover = kStrassenCrossover);
+
+}  // namespace s21
+
+#endif
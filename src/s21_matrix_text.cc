@@ -0,0 +1,244 @@
+#include "s21_matrix_text.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+// Bytes of formatted text buffered before a write to the stream
+constexpr std::size_t kWriteChunk = std::size_t{1} << 20;
+// Lines of a chunk are split into this many pieces per pool thread
+constexpr int kPiecesPerThread = 4;
+
+bool isSeparator(char c) {
+  return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* lineEnd(const char* p, const char* end) {
+  const void* newline = std::memchr(p, '\n', end - p);
+  return newline ? static_cast<const char*>(newline) : end;
+}
+
+bool isBlank(const char* p, const char* end) {
+  return std::all_of(p, end, isSeparator);
+}
+
+// Parses the values of the line [p, end) into out, at most capacity of
+// them, and returns their number
+int parseLine(const char* p, const char* end, double* out, int capacity) {
+  int count = 0;
+  for (;;) {
+    while (p < end && isSeparator(*p)) p++;
+    if (p == end) return count;
+    if (count == capacity) {
+      throw std::invalid_argument("Rows of the matrix differ in length");
+    }
+    if (*p == '+') p++;
+    auto [next, error] = std::from_chars(p, end, out[count]);
+    if (error != std::errc() || (next < end && !isSeparator(*next))) {
+      throw std::invalid_argument("Wrong value in matrix text");
+    }
+    count++;
+    p = next;
+  }
+}
+
+// Number of values on the line [p, end)
+int countValues(const char* p, const char* end) {
+  int count = 0;
+  while (p < end) {
+    while (p < end && isSeparator(*p)) p++;
+    if (p == end) break;
+    count++;
+    while (p < end && !isSeparator(*p)) p++;
+  }
+  return count;
+}
+
+// Parser state across the chunks of one stream
+class TextReader {
+ public:
+  explicit TextReader(bool parallel) : parallel_(parallel) {}
+
+  // Parses [begin, end), which holds complete lines only
+  void parseChunk(const char* begin, const char* end);
+  S21Matrix finish();
+
+ private:
+  struct Piece {
+    const char* begin;
+    const char* end;
+    int rows;
+    int firstRow;
+  };
+
+  void reserveRows(int rows);
+
+  bool parallel_;
+  S21Matrix matrix_{1, 1};
+  int rows_ = 0, cols_ = 0, capacity_ = 0;
+  std::vector<Piece> pieces_;
+};
+
+void TextReader::parseChunk(const char* begin, const char* end) {
+  if (cols_ == 0) {
+    // the first line with values fixes the width
+    while (begin < end) {
+      const char* stop = lineEnd(begin, end);
+      if (!isBlank(begin, stop)) {
+        cols_ = countValues(begin, stop);
+        break;
+      }
+      begin = stop + (stop < end);
+    }
+    if (cols_ == 0) return;
+  }
+
+  // split at line boundaries, one piece unless parsing in parallel
+  ThreadPool& pool = DefaultThreadPool();
+  int count = parallel_ ? pool.getThreads() * kPiecesPerThread : 1;
+  std::size_t step = (end - begin + count - 1) / count;
+  pieces_.clear();
+  for (const char* p = begin; p < end;) {
+    const char* stop = lineEnd(p + std::min<std::size_t>(step, end - p), end);
+    stop += stop < end;
+    pieces_.push_back({p, stop, 0, 0});
+    p = stop;
+  }
+
+  auto forEachPiece = [&](auto body) {
+    if (pieces_.size() == 1) {
+      body(pieces_[0]);
+    } else {
+      pool.ParallelFor(static_cast<int>(pieces_.size()),
+                       [&](int i) { body(pieces_[i]); });
+    }
+  };
+  forEachPiece([](Piece& piece) {
+    for (const char* p = piece.begin; p < piece.end;) {
+      const char* stop = lineEnd(p, piece.end);
+      if (!isBlank(p, stop)) piece.rows++;
+      p = stop + (stop < piece.end);
+    }
+  });
+
+  int rows = rows_;
+  for (Piece& piece : pieces_) {
+    piece.firstRow = rows;
+    rows += piece.rows;
+  }
+  reserveRows(rows);
+
+  double* data = matrix_.getData();
+  const int stride = matrix_.getStride(), cols = cols_;
+  forEachPiece([data, stride, cols](Piece& piece) {
+    int row = piece.firstRow;
+    for (const char* p = piece.begin; p < piece.end;) {
+      const char* stop = lineEnd(p, piece.end);
+      double* out = data + static_cast<std::ptrdiff_t>(row) * stride;
+      int values = parseLine(p, stop, out, cols);
+      if (values != 0 && values != cols) {
+        throw std::invalid_argument("Rows of the matrix differ in length");
+      }
+      row += values != 0;
+      p = stop + (stop < piece.end);
+    }
+  });
+  rows_ = rows;
+}
+
+// Grows the storage geometrically so appending costs amortized O(1)
+void TextReader::reserveRows(int rows) {
+  if (rows <= capacity_) return;
+  int capacity = std::max(rows, 2 * capacity_);
+  if (capacity_ == 0) {
+    matrix_ = S21Matrix(capacity, cols_);
+  } else {
+    matrix_.setRows(capacity);
+  }
+  capacity_ = capacity;
+}
+
+S21Matrix TextReader::finish() {
+  if (rows_ == 0) {
+    throw std::invalid_argument("Wrong parameters for matrix");
+  }
+  if (rows_ != capacity_) matrix_.setRows(rows_);
+  return std::move(matrix_);
+}
+
+}  // namespace
+
+S21Matrix ReadText(std::istream& in, const TextOptions& options) {
+  std::vector<char> buffer(std::max<std::size_t>(options.chunkBytes, 1));
+  std::size_t filled = 0;
+  TextReader reader(options.parallel);
+  for (bool more = true; more;) {
+    in.read(buffer.data() + filled,
+            static_cast<std::streamsize>(buffer.size() - filled));
+    filled += static_cast<std::size_t>(in.gcount());
+    if (in.bad()) throw std::runtime_error("Can not read matrix text");
+    more = static_cast<bool>(in);
+
+    // complete lines go to the parser, the partial last one waits for the
+    // next chunk
+    std::size_t complete = filled;
+    if (more) {
+      auto last = std::find(buffer.rbegin() + (buffer.size() - filled),
+                            buffer.rend(), '\n');
+      if (last == buffer.rend()) {
+        buffer.resize(2 * buffer.size());
+        continue;
+      }
+      complete = static_cast<std::size_t>(buffer.rend() - last);
+    }
+    reader.parseChunk(buffer.data(), buffer.data() + complete);
+    std::memmove(buffer.data(), buffer.data() + complete, filled - complete);
+    filled -= complete;
+  }
+  return reader.finish();
+}
+
+S21Matrix ReadText(const std::string& path, const TextOptions& options) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) throw std::runtime_error("Can not open " + path);
+  return ReadText(file, options);
+}
+
+void WriteText(std::ostream& out, S21ConstMatrixView matrix,
+               char delimiter) {
+  // room for the longest shortest-form double and its delimiter
+  constexpr std::size_t kValueBytes = 32;
+  std::vector<char> buffer(kWriteChunk + kValueBytes);
+  char* p = buffer.data();
+  char* const limit = buffer.data() + kWriteChunk;
+  for (int i = 0; i < matrix.getRows(); i++) {
+    for (int j = 0; j < matrix.getCols(); j++) {
+      p = std::to_chars(p, p + kValueBytes - 1, matrix(i, j)).ptr;
+      *p++ = j + 1 < matrix.getCols() ? delimiter : '\n';
+      if (p >= limit) {
+        out.write(buffer.data(), p - buffer.data());
+        p = buffer.data();
+      }
+    }
+  }
+  out.write(buffer.data(), p - buffer.data());
+  if (!out.flush()) throw std::runtime_error("Can not write matrix text");
+}
+
+void WriteText(const std::string& path, S21ConstMatrixView matrix,
+               char delimiter) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("Can not open " + path);
+  WriteText(file, matrix, delimiter);
+}
+
+}  // namespace s21
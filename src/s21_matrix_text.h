@@ -0,0 +1,40 @@
+#ifndef S21_MATRIX_TEXT_H_
+#define S21_MATRIX_TEXT_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+struct TextOptions {
+  // Bytes read from the stream at a time, a chunk grows only to fit a line
+  // longer than this
+  std::size_t chunkBytes = std::size_t{4} << 20;
+  // Parse the lines of each chunk on the default thread pool
+  bool parallel = false;
+};
+
+// Reads a matrix written one row per line, values separated by commas,
+// semicolons, spaces or tabs (runs of separators count as one). Blank
+// lines are skipped and CRLF line ends are accepted. The stream is parsed
+// chunk by chunk with std::from_chars straight into the matrix storage,
+// so the text is never held in memory as a whole. std::invalid_argument
+// for a malformed value, rows of different lengths or no values at all
+S21Matrix ReadText(std::istream& in, const TextOptions& options = {});
+// Same for a file, std::runtime_error if it can not be opened
+S21Matrix ReadText(const std::string& path, const TextOptions& options = {});
+
+// Writes one row per line with std::to_chars, each value in the shortest
+// form that reads back to the same double
+void WriteText(std::ostream& out, S21ConstMatrixView matrix,
+               char delimiter = ',');
+// Same for a file, std::runtime_error if it can not be written
+void WriteText(const std::string& path, S21ConstMatrixView matrix,
+               char delimiter = ',');
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,91 @@
+#include "s21_matrix_transpose.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "s21_matrix_arena.h"
+
+namespace s21 {
+
+template <class T>
+void TransposeCopy(int rows, int cols, const T* src, int lds, T* dst,
+                   int ldd) {
+  if (rows <= kTransposeBlock && cols <= kTransposeBlock) {
+    for (int i = 0; i < rows; i++) {
+      const T* row = src + i * static_cast<std::ptrdiff_t>(lds);
+      for (int j = 0; j < cols; j++) {
+        dst[j * static_cast<std::ptrdiff_t>(ldd) + i] = row[j];
+      }
+    }
+  } else if (rows >= cols) {
+    int half = rows / 2;
+    TransposeCopy(half, cols, src, lds, dst, ldd);
+    TransposeCopy(rows - half, cols,
+                  src + half * static_cast<std::ptrdiff_t>(lds), lds,
+                  dst + half, ldd);
+  } else {
+    int half = cols / 2;
+    TransposeCopy(rows, half, src, lds, dst, ldd);
+    TransposeCopy(rows, cols - half, src + half, lds,
+                  dst + half * static_cast<std::ptrdiff_t>(ldd), ldd);
+  }
+}
+
+template <class T>
+void TransposeSquare(int n, T* a, int lda) {
+  auto at = [a, lda](int i, int j) -> T& {
+    return a[i * static_cast<std::ptrdiff_t>(lda) + j];
+  };
+  for (int i0 = 0; i0 < n; i0 += kTransposeBlock) {
+    int i1 = std::min(i0 + kTransposeBlock, n);
+    // diagonal tile
+    for (int i = i0; i < i1; i++) {
+      for (int j = i + 1; j < i1; j++) std::swap(at(i, j), at(j, i));
+    }
+    // tiles right of the diagonal swap with their mirror below it
+    for (int j0 = i1; j0 < n; j0 += kTransposeBlock) {
+      int j1 = std::min(j0 + kTransposeBlock, n);
+      for (int i = i0; i < i1; i++) {
+        for (int j = j0; j < j1; j++) std::swap(at(i, j), at(j, i));
+      }
+    }
+  }
+}
+
+template <class T>
+void TransposeCycles(int rows, int cols, T* a) {
+  if (rows <= 1 || cols <= 1) return;
+  // element k = i * cols + j moves to j * rows + i = k * rows mod (size - 1),
+  // the first and last elements stay in place
+  const long long last = static_cast<long long>(rows) * cols - 1;
+  const std::size_t words = static_cast<std::size_t>(last) / 64 + 1;
+  ArenaBuffer<std::uint64_t> moved(words);
+  std::fill_n(moved.data(), words, 0);
+  auto isMoved = [&moved](long long k) { return moved[k / 64] >> k % 64 & 1; };
+  for (long long start = 1; start < last; start++) {
+    if (isMoved(start)) continue;
+    long long k = start;
+    T carried = a[k];
+    do {
+      long long next = k * rows % last;
+      std::swap(a[next], carried);
+      moved[next / 64] |= std::uint64_t{1} << next % 64;
+      k = next;
+    } while (k != start);
+  }
+}
+
+#define S21_TRANSPOSE_INSTANTIATE(T)                                      \
+  template void TransposeCopy(int, int, const T*, int, T*, int);          \
+  template void TransposeSquare(int, T*, int);                            \
+  template void TransposeCycles(int, int, T*);
+
+S21_TRANSPOSE_INSTANTIATE(float)
+S21_TRANSPOSE_INSTANTIATE(double)
+S21_TRANSPOSE_INSTANTIATE(long double)
+S21_TRANSPOSE_INSTANTIATE(std::complex<double>)
+
+}  // namespace s21
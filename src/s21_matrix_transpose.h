@@ -0,0 +1,30 @@
+#ifndef S21_MATRIX_TRANSPOSE_H_
+#define S21_MATRIX_TRANSPOSE_H_
+
+namespace s21 {
+
+// Each transpose is instantiated for the matrix element types (see
+// s21_matrix_scalar.h)
+
+// Edge of the tiles the recursive transposes bottom out at
+constexpr int kTransposeBlock = 32;
+
+// dst = src^T: src is rows x cols with row stride lds, dst is cols x rows
+// with row stride ldd. Cache-oblivious: the larger dimension is halved
+// until a tile fits in L1, so both sides are read and written in tiles
+template <class T>
+void TransposeCopy(int rows, int cols, const T* src, int lds, T* dst, int ldd);
+
+// In-place transpose of the n x n matrix a with row stride lda, tile pairs
+// across the diagonal are swapped
+template <class T>
+void TransposeSquare(int n, T* a, int lda);
+
+// In-place transpose of a contiguous rows x cols matrix into cols x rows by
+// following the permutation cycles; needs rows * cols / 8 bytes of marks
+template <class T>
+void TransposeCycles(int rows, int cols, T* a);
+
+}  // namespace s21
+
+#endif
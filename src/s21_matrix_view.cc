@@ -0,0 +1,219 @@
+#include "s21_matrix_view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include "s21_matrix_arena.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_transpose.h"
+
+namespace s21 {
+
+namespace {
+
+// Visits the elements of a rows x cols region in kTransposeBlock tiles, so a
+// view walked against its strides still reads whole cache lines; stops at
+// the first visit that returns false
+template <class Visit>
+bool visitTiles(int rows, int cols, Visit visit) {
+  for (int i0 = 0; i0 < rows; i0 += kTransposeBlock) {
+    int i1 = std::min(i0 + kTransposeBlock, rows);
+    for (int j0 = 0; j0 < cols; j0 += kTransposeBlock) {
+      int j1 = std::min(j0 + kTransposeBlock, cols);
+      for (int i = i0; i < i1; i++) {
+        for (int j = j0; j < j1; j++) {
+          if (!visit(i, j)) return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <class A, class B>
+void checkSameSize(const A& a, const B& b) {
+  if (a.getRows() != b.getRows() || a.getCols() != b.getCols()) {
+    throw std::invalid_argument("Different matrix dimensions");
+  }
+}
+
+// True if the address ranges spanned by the two views intersect
+template <class T>
+bool overlaps(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b) {
+  const T* aLast = &a(a.getRows() - 1, a.getCols() - 1);
+  const T* bLast = &b(b.getRows() - 1, b.getCols() - 1);
+  return a.getData() <= bLast && b.getData() <= aLast;
+}
+
+// Every element of a sits where the same element of b does
+template <class T>
+bool sameLayout(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b) {
+  return a.getData() == b.getData() && a.getRowStride() == b.getRowStride() &&
+         a.getColStride() == b.getColStride();
+}
+
+// dst op= src: run(dstRun, srcRun, length) gets matching contiguous runs
+// when both layouts have them, element(dst, src) the rest one by one
+template <class T, class Run, class Element>
+void elementwise(S21BasicMatrixView<T> dst, S21BasicMatrixView<const T> src,
+                 Run run, Element element) {
+  checkSameSize(dst, src);
+  if (overlaps<T>(dst, src) && !sameLayout<T>(dst, src)) {
+    ArenaBuffer<T> copy(static_cast<std::size_t>(src.getRows()) *
+                        src.getCols());
+    S21BasicMatrixView<T> copyView(copy.data(), src.getRows(), src.getCols(),
+                                   src.getCols());
+    CopyView<T>(src, copyView);
+    elementwise<T>(dst, copyView, run, element);
+  } else if (dst.isRowMajor() && src.isRowMajor()) {
+    for (int i = 0; i < dst.getRows(); i++) {
+      run(&dst(i, 0), &src(i, 0), dst.getCols());
+    }
+  } else if (dst.Transposed().isRowMajor() && src.Transposed().isRowMajor()) {
+    for (int j = 0; j < dst.getCols(); j++) {
+      run(&dst(0, j), &src(0, j), dst.getRows());
+    }
+  } else {
+    visitTiles(dst.getRows(), dst.getCols(), [&](int i, int j) {
+      element(dst(i, j), src(i, j));
+      return true;
+    });
+  }
+}
+
+}  // namespace
+
+template <class T>
+void CopyView(S21BasicMatrixView<const NonDeduced<T>> src,
+              S21BasicMatrixView<T> dst) {
+  checkSameSize(dst, src);
+  if (dst.isRowMajor() && src.isTransposed() && !overlaps<T>(dst, src)) {
+    TransposeCopy(src.getCols(), src.getRows(), src.getData(),
+                  src.getColStride(), dst.getData(), dst.getRowStride());
+    return;
+  }
+  elementwise<T>(
+      dst, src, [](T* to, const T* from, int n) { std::copy_n(from, n, to); },
+      [](T& to, const T& from) { to = from; });
+}
+
+template <class T>
+void CopyView(S21BasicMinorView<const NonDeduced<T>> src,
+              S21BasicMatrixView<T> dst) {
+  checkSameSize(dst, src);
+  src.forEachBlock([dst](S21BasicMatrixView<const T> block, int row, int col) {
+    CopyView<T>(block, dst.Block(row, col, block.getRows(), block.getCols()));
+  });
+}
+
+template <class T>
+void AddView(S21BasicMatrixView<T> dst,
+             S21BasicMatrixView<const NonDeduced<T>> src) {
+  elementwise<T>(
+      dst, src,
+      [](T* to, const T* from, int n) { SimdFor<T>().add(to, to, from, n); },
+      [](T& to, const T& from) { to += from; });
+}
+
+template <class T>
+void SubView(S21BasicMatrixView<T> dst,
+             S21BasicMatrixView<const NonDeduced<T>> src) {
+  elementwise<T>(
+      dst, src,
+      [](T* to, const T* from, int n) { SimdFor<T>().sub(to, to, from, n); },
+      [](T& to, const T& from) { to -= from; });
+}
+
+template <class T>
+void ScaleView(S21BasicMatrixView<T> dst, NonDeduced<T> num) {
+  if (!dst.isRowMajor()) dst = dst.Transposed();
+  if (dst.isRowMajor()) {
+    for (int i = 0; i < dst.getRows(); i++) {
+      SimdFor<T>().scale(&dst(i, 0), &dst(i, 0), num, dst.getCols());
+    }
+  } else {
+    visitTiles(dst.getRows(), dst.getCols(), [&](int i, int j) {
+      dst(i, j) *= num;
+      return true;
+    });
+  }
+}
+
+template <class T>
+bool EqualViews(S21BasicMatrixView<const T> a,
+                S21BasicMatrixView<const NonDeduced<T>> b, double tolerance) {
+  if (a.getRows() != b.getRows() || a.getCols() != b.getCols()) {
+    return false;
+  }
+  if (!a.isRowMajor() || !b.isRowMajor()) {
+    if (a.Transposed().isRowMajor() && b.Transposed().isRowMajor()) {
+      a = a.Transposed();
+      b = b.Transposed();
+    }
+  }
+  if (a.isRowMajor() && b.isRowMajor()) {
+    for (int i = 0; i < a.getRows(); i++) {
+      if (!SimdFor<T>().equal(&a(i, 0), &b(i, 0), a.getCols(), tolerance)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return visitTiles(a.getRows(), a.getCols(), [&](int i, int j) {
+    return std::abs(a(i, j) - b(i, j)) <= tolerance;
+  });
+}
+
+template <class T>
+void GemmView(S21BasicMatrixView<T> c,
+              S21BasicMatrixView<const NonDeduced<T>> a,
+              S21BasicMatrixView<const NonDeduced<T>> b,
+              NonDeduced<T> alpha) {
+  if (a.getCols() != b.getRows() || c.getRows() != a.getRows() ||
+      c.getCols() != b.getCols()) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  if (overlaps<T>(c, a) || overlaps<T>(c, b) ||
+      (!c.isRowMajor() && !c.Transposed().isRowMajor())) {
+    // the kernel writes C while still reading A and B, and needs
+    // contiguous rows (or columns) in C
+    std::size_t size = static_cast<std::size_t>(c.getRows()) * c.getCols();
+    ArenaBuffer<T> product(size);
+    std::fill_n(product.data(), size, T(0));
+    S21BasicMatrixView<T> result(product.data(), c.getRows(), c.getCols(),
+                                 c.getCols());
+    GemmView<T>(result, a, b, alpha);
+    AddView<T>(c, result);
+  } else if (c.isRowMajor()) {
+    GemmStrided(c.getRows(), c.getCols(), a.getCols(), a.getData(),
+                a.getRowStride(), a.getColStride(), b.getData(),
+                b.getRowStride(), b.getColStride(), c.getData(),
+                c.getRowStride(), alpha);
+  } else {
+    // C^T += alpha * B^T * A^T has contiguous rows
+    GemmStrided(c.getCols(), c.getRows(), a.getCols(), b.getData(),
+                b.getColStride(), b.getRowStride(), a.getData(),
+                a.getColStride(), a.getRowStride(), c.getData(),
+                c.getColStride(), alpha);
+  }
+}
+
+#define S21_VIEW_INSTANTIATE(T)                                              \
+  template void CopyView(S21BasicMatrixView<const T>, S21BasicMatrixView<T>); \
+  template void CopyView(S21BasicMinorView<const T>, S21BasicMatrixView<T>);  \
+  template void AddView(S21BasicMatrixView<T>, S21BasicMatrixView<const T>);  \
+  template void SubView(S21BasicMatrixView<T>, S21BasicMatrixView<const T>);  \
+  template void ScaleView(S21BasicMatrixView<T>, T);                          \
+  template bool EqualViews(S21BasicMatrixView<const T>,                       \
+                           S21BasicMatrixView<const T>, double);              \
+  template void GemmView(S21BasicMatrixView<T>, S21BasicMatrixView<const T>,  \
+                         S21BasicMatrixView<const T>, T);
+
+S21_VIEW_INSTANTIATE(float)
+S21_VIEW_INSTANTIATE(double)
+S21_VIEW_INSTANTIATE(long double)
+S21_VIEW_INSTANTIATE(std::complex<double>)
+
+}  // namespace s21
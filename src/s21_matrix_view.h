@@ -0,0 +1,174 @@
+#ifndef S21_MATRIX_VIEW_H_
+#define S21_MATRIX_VIEW_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_scalar.h"
+
+// Non-owning rows x cols window over someone else's elements: element
+// (i, j) lives at data[i * rowStride + j * colStride]. A transposed view is
+// the same storage with dimensions and strides swapped, so kernels that
+// take a view read it in place instead of copying it first
+template <class T>
+class S21BasicMatrixView {
+ public:
+  S21BasicMatrixView(T* data, int rows, int cols, int rowStride,
+                     int colStride = 1)
+      : data_(data),
+        rows_(rows),
+        cols_(cols),
+        rowStride_(rowStride),
+        colStride_(colStride) {}
+  // A view of mutable elements is also a view of const ones
+  template <class U, class = std::enable_if_t<std::is_same_v<T, const U>>>
+  S21BasicMatrixView(const S21BasicMatrixView<U>& other)
+      : S21BasicMatrixView(other.getData(), other.getRows(), other.getCols(),
+                           other.getRowStride(), other.getColStride()) {}
+
+  // accessors
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  int getRowStride() const { return rowStride_; }
+  int getColStride() const { return colStride_; }
+  T* getData() const { return data_; }
+  // Rows are contiguous runs of elements
+  bool isRowMajor() const { return colStride_ == 1 || cols_ == 1; }
+  // Columns are contiguous runs of elements (the view of a transpose)
+  bool isTransposed() const { return !isRowMajor() && rowStride_ == 1; }
+
+  T& operator()(int row, int col) const {
+    return data_[row * static_cast<std::ptrdiff_t>(rowStride_) +
+                 col * static_cast<std::ptrdiff_t>(colStride_)];
+  }
+
+  // Same elements read as the transpose, nothing is moved
+  S21BasicMatrixView Transposed() const {
+    return S21BasicMatrixView(data_, cols_, rows_, colStride_, rowStride_);
+  }
+
+  // rows x cols block whose top left element is (row, col)
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const {
+    if (row < 0 || col < 0 || rows <= 0 || cols <= 0) {
+      throw std::invalid_argument("Zero or negative parameters for matrix");
+    } else if (row + rows > rows_ || col + cols > cols_) {
+      throw std::invalid_argument("There are no such parameters for matrix");
+    }
+    return S21BasicMatrixView(&(*this)(row, col), rows, cols, rowStride_,
+                              colStride_);
+  }
+  S21BasicMatrixView Row(int row) const { return Block(row, 0, 1, cols_); }
+  S21BasicMatrixView Col(int col) const { return Block(0, col, rows_, 1); }
+
+ private:
+  T* data_;
+  int rows_, cols_;
+  int rowStride_, colStride_;
+};
+
+// The matrix seen through a view with one row and one column left out,
+// i.e. the minor's submatrix. It is not a single strided window, so
+// kernels consume it as up to four blocks
+template <class T>
+class S21BasicMinorView {
+ public:
+  S21BasicMinorView(S21BasicMatrixView<T> base, int banRow, int banCol)
+      : base_(base), banRow_(banRow), banCol_(banCol) {
+    if (banRow < 0 || banCol < 0) {
+      throw std::invalid_argument("Zero or negative parameters for matrix");
+    } else if (banRow >= base.getRows() || banCol >= base.getCols()) {
+      throw std::invalid_argument("There are no such parameters for matrix");
+    } else if (base.getRows() < 2 || base.getCols() < 2) {
+      throw std::invalid_argument("Wrong parameters for matrix");
+    }
+  }
+
+  template <class U, class = std::enable_if_t<std::is_same_v<T, const U>>>
+  S21BasicMinorView(const S21BasicMinorView<U>& other)
+      : base_(other.getBase()),
+        banRow_(other.getBanRow()),
+        banCol_(other.getBanCol()) {}
+
+  // accessors
+  int getRows() const { return base_.getRows() - 1; }
+  int getCols() const { return base_.getCols() - 1; }
+  S21BasicMatrixView<T> getBase() const { return base_; }
+  int getBanRow() const { return banRow_; }
+  int getBanCol() const { return banCol_; }
+
+  T& operator()(int row, int col) const {
+    return base_(row + (row >= banRow_), col + (col >= banCol_));
+  }
+
+  // Calls visit(block, row, col) for every non-empty block, (row, col) is
+  // the position of the block's first element inside the minor
+  template <class Visit>
+  void forEachBlock(Visit visit) const {
+    int rowSizes[] = {banRow_, getRows() - banRow_};
+    int colSizes[] = {banCol_, getCols() - banCol_};
+    for (int r = 0; r < 2; r++) {
+      if (!rowSizes[r]) continue;
+      for (int c = 0; c < 2; c++) {
+        if (!colSizes[c]) continue;
+        visit(base_.Block(r * (banRow_ + 1), c * (banCol_ + 1), rowSizes[r],
+                          colSizes[c]),
+              r * banRow_, c * banCol_);
+      }
+    }
+  }
+
+ private:
+  S21BasicMatrixView<T> base_;
+  int banRow_, banCol_;
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21ConstMatrixView = S21BasicMatrixView<const double>;
+using S21MinorView = S21BasicMinorView<double>;
+using S21ConstMinorView = S21BasicMinorView<const double>;
+
+namespace s21 {
+
+// Kernels over views. Dimension mismatches throw std::invalid_argument;
+// rows are handed to the SIMD kernels when both sides have contiguous rows
+// (or both contiguous columns), any other layout is walked in tiles. A
+// source overlapping the destination in a different layout is copied first.
+// The element type is deduced from the destination (the first operand of
+// EqualViews) and the other operands convert to it, so mutable views can be
+// passed as sources
+
+// dst = src
+template <class T>
+void CopyView(S21BasicMatrixView<const NonDeduced<T>> src,
+              S21BasicMatrixView<T> dst);
+// dst = the minor src
+template <class T>
+void CopyView(S21BasicMinorView<const NonDeduced<T>> src,
+              S21BasicMatrixView<T> dst);
+// dst += src
+template <class T>
+void AddView(S21BasicMatrixView<T> dst,
+             S21BasicMatrixView<const NonDeduced<T>> src);
+// dst -= src
+template <class T>
+void SubView(S21BasicMatrixView<T> dst,
+             S21BasicMatrixView<const NonDeduced<T>> src);
+// dst *= num
+template <class T>
+void ScaleView(S21BasicMatrixView<T> dst, NonDeduced<T> num);
+// All elements of a and b are within tolerance, false on differing sizes
+template <class T>
+bool EqualViews(S21BasicMatrixView<const T> a,
+                S21BasicMatrixView<const NonDeduced<T>> b, double tolerance);
+// c += alpha * a * b
+template <class T>
+void GemmView(S21BasicMatrixView<T> c,
+              S21BasicMatrixView<const NonDeduced<T>> a,
+              S21BasicMatrixView<const NonDeduced<T>> b,
+              NonDeduced<T> alpha = T(1));
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,150 @@
+#include "s21_refined_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_matrix_lu.h"
+#include "s21_matrix_view.h"
+
+namespace {
+
+// Row by row through the buffer: the matrix's own operator() is bounds
+// checked and bumps the version on every element
+S21FloatMatrix toFloat(S21Matrix::ConstMatrixView view) {
+  S21FloatMatrix result(view.getRows(), view.getCols());
+  float* data = result.getData();
+  for (int i = 0; i < view.getRows(); i++) {
+    float* row = data + i * static_cast<std::ptrdiff_t>(result.getStride());
+    for (int j = 0; j < view.getCols(); j++) {
+      row[j] = s21::ConvertScalar<float>(view(i, j));
+    }
+  }
+  return result;
+}
+
+// Largest magnitude in each column
+std::vector<double> columnNorms(S21Matrix::ConstMatrixView m) {
+  std::vector<double> norms(m.getCols(), 0.0);
+  for (int i = 0; i < m.getRows(); i++) {
+    for (int j = 0; j < m.getCols(); j++) {
+      norms[j] = std::max(norms[j], std::abs(m(i, j)));
+    }
+  }
+  return norms;
+}
+
+// b - a * x. A single right-hand side is a matrix-vector product: the
+// packed GEMM would pad x to a full register tile and repack a per call
+S21Matrix residualOf(const S21Matrix& a, S21Matrix::ConstMatrixView b,
+                     const S21Matrix& x) {
+  S21Matrix r(b);
+  if (x.getCols() > 1) {
+    s21::GemmView(r.View(), a.View(), x.View(), -1.0);
+    return r;
+  }
+  const int n = a.getCols();
+  std::vector<double> column(n);
+  const S21Matrix::ConstMatrixView xv = x.View();
+  for (int j = 0; j < n; j++) column[j] = xv(j, 0);
+  const S21Matrix::MatrixView rv = r.View();
+  for (int i = 0; i < a.getRows(); i++) {
+    const double* row = a.getData() + i * static_cast<std::ptrdiff_t>(
+                                              a.getStride());
+    // four partial sums keep the adds from serialising on one register
+    double sums[4] = {};
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+      for (int u = 0; u < 4; u++) sums[u] += row[j + u] * column[j + u];
+    }
+    for (; j < n; j++) sums[0] += row[j] * column[j];
+    rv(i, 0) -= (sums[0] + sums[1]) + (sums[2] + sums[3]);
+  }
+  return r;
+}
+
+}  // namespace
+
+S21RefinedSolver::S21RefinedSolver(S21Matrix::ConstMatrixView matrix,
+                                   int maxIterations)
+    : matrix_(matrix),
+      single_(S21FloatMatrix(matrix_)),
+      maxIterations_(maxIterations) {
+  const int n = getSize();
+  const S21Matrix::ConstMatrixView a = matrix_.View();
+  double norm = 0;
+  for (int i = 0; i < n; i++) {
+    double sum = 0;
+    for (int j = 0; j < n; j++) sum += std::abs(a(i, j));
+    norm = std::max(norm, sum);
+  }
+  tolerance_ =
+      norm * std::sqrt(n) * std::numeric_limits<double>::epsilon();
+  // elements past the float range turn into infinities in the copy
+  singleUsable_ = !single_.isSingular() &&
+                  s21::MaxAbs(n, n, matrix_.getData(), matrix_.getStride()) <=
+                      std::numeric_limits<float>::max();
+}
+
+S21RefinedSolver::~S21RefinedSolver() = default;
+
+const S21LuSolver& S21RefinedSolver::doubleSolver() {
+  if (!double_) double_ = std::make_unique<S21LuSolver>(matrix_);
+  return *double_;
+}
+
+bool S21RefinedSolver::refine(S21Matrix::ConstMatrixView b, S21Matrix& x) {
+  S21FloatMatrix correction = toFloat(b);
+  single_.SolveInPlace(correction);
+  x = S21Matrix(correction);
+
+  double previous = std::numeric_limits<double>::infinity();
+  for (;;) {
+    // r = b - A * x in double, the step that recovers the lost digits
+    S21Matrix residual = residualOf(matrix_, b, x);
+
+    std::vector<double> xNorms = columnNorms(x);
+    std::vector<double> rNorms = columnNorms(residual);
+    bool converged = true;
+    double worst = 0;
+    for (int j = 0; j < x.getCols(); j++) {
+      converged = converged && rNorms[j] <= xNorms[j] * tolerance_;
+      worst = std::max(worst, rNorms[j] / xNorms[j]);
+    }
+    if (converged) return true;
+    // a residual that does not shrink (or is not finite) means the float
+    // factors are too inaccurate for this matrix
+    if (iterations_ == maxIterations_ || !(worst < previous)) return false;
+    previous = worst;
+
+    correction = toFloat(residual);
+    single_.SolveInPlace(correction);
+    s21::AddView(x.View(), S21Matrix(correction).View());
+    iterations_++;
+  }
+}
+
+S21Matrix S21RefinedSolver::Solve(S21Matrix::ConstMatrixView b) {
+  if (b.getRows() != getSize()) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  iterations_ = 0;
+  fallback_ = false;
+  S21Matrix x;
+  if (singleUsable_ && refine(b, x)) return x;
+  fallback_ = true;
+  return doubleSolver().Solve(b);
+}
+
+std::vector<double> S21RefinedSolver::Solve(const std::vector<double>& b) {
+  const int n = static_cast<int>(b.size());
+  if (n != getSize()) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  S21Matrix column(n, 1);
+  std::copy(b.begin(), b.end(), column.getData());
+  const S21Matrix x = Solve(column.View());
+  return std::vector<double>(x.getData(), x.getData() + n);
+}
@@ -0,0 +1,54 @@
+#ifndef S21_REFINED_SOLVER_H_
+#define S21_REFINED_SOLVER_H_
+
+#include <memory>
+#include <vector>
+
+#include "s21_lu_solver.h"
+
+// Mixed-precision solver for A * x = b: a float copy of A is factored once,
+// then each solve refines the float solution to double accuracy with
+// residuals r = b - A * x computed in double against the original matrix
+// and corrections A * d = r solved with the float factors. If the float
+// copy is singular or overflows, or the residual stops shrinking, the solve
+// falls back to a double factorization, which is then kept for later solves
+class S21RefinedSolver {
+ public:
+  // Refinement steps per solve before falling back
+  static constexpr int kMaxIterations = 30;
+
+  // Throws "Matrix is not square" for a non-square matrix
+  explicit S21RefinedSolver(S21Matrix::ConstMatrixView matrix,
+                            int maxIterations = kMaxIterations);
+  ~S21RefinedSolver();
+
+  // accessors
+  int getSize() const { return matrix_.getRows(); }
+  int getMaxIterations() const { return maxIterations_; }
+  // Refinement steps taken by the last solve
+  int getIterations() const { return iterations_; }
+  // The last solve was answered by the double factorization
+  bool isFallback() const { return fallback_; }
+
+  // x with A * x = b
+  std::vector<double> Solve(const std::vector<double>& b);
+  // X with A * X = B, refined until every column has converged
+  S21Matrix Solve(S21Matrix::ConstMatrixView b);
+
+ private:
+  bool refine(S21Matrix::ConstMatrixView b, S21Matrix& x);
+  const S21LuSolver& doubleSolver();
+
+  S21Matrix matrix_;
+  S21BasicLuSolver<float> single_;
+  std::unique_ptr<S21LuSolver> double_;
+  // ||A||_inf * sqrt(n) * epsilon, a column of x has converged once its
+  // residual is below this times its own largest element
+  double tolerance_;
+  bool singleUsable_;
+  int maxIterations_;
+  int iterations_ = 0;
+  bool fallback_ = false;
+};
+
+#endif
@@ -0,0 +1,333 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Products with fewer multiply-adds than this stay on the calling thread
+constexpr double kSparseParallel = 1 << 16;
+
+// Runs body(begin, end) over [0, count) lines, split across the default
+// pool when work is large enough
+template <class Body>
+void forLines(int count, double work, Body body) {
+  s21::ThreadPool& pool = s21::DefaultThreadPool();
+  int chunks = std::min(count, 4 * pool.getThreads());
+  if (work < kSparseParallel || chunks <= 1) {
+    body(0, count);
+    return;
+  }
+  int step = (count + chunks - 1) / chunks;
+  pool.ParallelFor((count + step - 1) / step, [&](int chunk) {
+    body(chunk * step, std::min(count, (chunk + 1) * step));
+  });
+}
+
+void checkIndex(int row, int col, int rows, int cols) {
+  if (row < 0 || col < 0) {
+    throw std::invalid_argument("Zero or negative parameters for matrix");
+  } else if (row >= rows || col >= cols) {
+    throw std::invalid_argument("There are no such parameters for matrix");
+  }
+}
+
+}  // namespace
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols, Format format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows_ <= 0 || cols_ <= 0) {
+    throw std::invalid_argument("Wrong parameters for matrix");
+  }
+  offsets_.assign(lines() + 1, 0);
+}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols,
+                                 const std::vector<Triplet>& triplets,
+                                 Format format)
+    : S21SparseMatrix(rows, cols, format) {
+  const bool csr = format_ == Format::kCsr;
+  for (const Triplet& t : triplets) {
+    checkIndex(t.row, t.col, rows_, cols_);
+    offsets_[(csr ? t.row : t.col) + 1]++;
+  }
+  for (int l = 0; l < lines(); l++) offsets_[l + 1] += offsets_[l];
+
+  // bucket by line, then sort each line and sum duplicates in place
+  std::vector<std::pair<int, double>> entries(triplets.size());
+  std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+  for (const Triplet& t : triplets) {
+    entries[next[csr ? t.row : t.col]++] = {csr ? t.col : t.row, t.value};
+  }
+  indices_.reserve(entries.size());
+  values_.reserve(entries.size());
+  std::size_t begin = 0;
+  for (int l = 0; l < lines(); l++) {
+    std::size_t end = offsets_[l + 1];
+    std::sort(entries.begin() + begin, entries.begin() + end,
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    offsets_[l] = indices_.size();
+    for (std::size_t k = begin; k < end;) {
+      int index = entries[k].first;
+      double sum = 0;
+      for (; k < end && entries[k].first == index; k++) {
+        sum += entries[k].second;
+      }
+      if (sum != 0) {
+        indices_.push_back(index);
+        values_.push_back(sum);
+      }
+    }
+    begin = end;
+  }
+  offsets_[lines()] = indices_.size();
+}
+
+S21SparseMatrix::S21SparseMatrix(const S21Matrix& dense, double threshold,
+                                 Format format)
+    : S21SparseMatrix(dense.getRows(), dense.getCols(), Format::kCsr) {
+  for (int i = 0; i < rows_; i++) {
+    const double* row = dense.getMatrix()[i];
+    for (int j = 0; j < cols_; j++) {
+      if (std::abs(row[j]) > threshold) {
+        indices_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    offsets_[i + 1] = indices_.size();
+  }
+  if (format != Format::kCsr) *this = converted();
+}
+
+double S21SparseMatrix::operator()(int row, int col) const {
+  checkIndex(row, col, rows_, cols_);
+  const bool csr = format_ == Format::kCsr;
+  int line = csr ? row : col, index = csr ? col : row;
+  auto begin = indices_.begin() + offsets_[line];
+  auto end = indices_.begin() + offsets_[line + 1];
+  auto found = std::lower_bound(begin, end, index);
+  return found != end && *found == index ? values_[found - indices_.begin()]
+                                         : 0;
+}
+
+S21Matrix S21SparseMatrix::ToDense() const {
+  S21Matrix result(rows_, cols_);
+  // mutable access bumps the version, so it is taken once
+  double* const data = result.getData();
+  const std::ptrdiff_t stride = result.getStride();
+  const bool csr = format_ == Format::kCsr;
+  for (int l = 0; l < lines(); l++) {
+    for (std::size_t k = offsets_[l]; k < offsets_[l + 1]; k++) {
+      if (csr) {
+        data[l * stride + indices_[k]] = values_[k];
+      } else {
+        data[indices_[k] * stride + l] = values_[k];
+      }
+    }
+  }
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::ToCsr() const {
+  return format_ == Format::kCsr ? *this : converted();
+}
+
+S21SparseMatrix S21SparseMatrix::ToCsc() const {
+  return format_ == Format::kCsc ? *this : converted();
+}
+
+// Counting sort by index: walking the lines in order leaves every new line
+// sorted
+S21SparseMatrix S21SparseMatrix::converted() const {
+  S21SparseMatrix result(rows_, cols_,
+                         format_ == Format::kCsr ? Format::kCsc
+                                                 : Format::kCsr);
+  for (int index : indices_) result.offsets_[index + 1]++;
+  for (int l = 0; l < result.lines(); l++) {
+    result.offsets_[l + 1] += result.offsets_[l];
+  }
+  result.indices_.resize(getNonZeros());
+  result.values_.resize(getNonZeros());
+  std::vector<std::size_t> next(result.offsets_.begin(),
+                                result.offsets_.end() - 1);
+  for (int l = 0; l < lines(); l++) {
+    for (std::size_t k = offsets_[l]; k < offsets_[l + 1]; k++) {
+      std::size_t to = next[indices_[k]]++;
+      result.indices_[to] = l;
+      result.values_[to] = values_[k];
+    }
+  }
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::Transpose() const {
+  S21SparseMatrix result(*this);
+  std::swap(result.rows_, result.cols_);
+  result.format_ =
+      format_ == Format::kCsr ? Format::kCsc : Format::kCsr;
+  return result;
+}
+
+std::vector<double> S21SparseMatrix::MulVector(
+    const std::vector<double>& x) const {
+  if (x.size() != static_cast<std::size_t>(cols_)) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  std::vector<double> y(rows_);
+  if (format_ == Format::kCsr) {
+    forLines(rows_, static_cast<double>(getNonZeros()),
+             [&](int begin, int end) {
+               for (int i = begin; i < end; i++) {
+                 double sum = 0;
+                 for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; k++) {
+                   sum += values_[k] * x[indices_[k]];
+                 }
+                 y[i] = sum;
+               }
+             });
+  } else {
+    for (int j = 0; j < cols_; j++) {
+      for (std::size_t k = offsets_[j]; k < offsets_[j + 1]; k++) {
+        y[indices_[k]] += values_[k] * x[j];
+      }
+    }
+  }
+  return y;
+}
+
+// Merges the sorted lines of both operands
+S21SparseMatrix S21SparseMatrix::combined(const S21SparseMatrix& other,
+                                          double sign) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Different matrix dimensions");
+  }
+  if (other.format_ != format_) return combined(other.converted(), sign);
+
+  S21SparseMatrix result(rows_, cols_, format_);
+  result.indices_.reserve(getNonZeros() + other.getNonZeros());
+  result.values_.reserve(getNonZeros() + other.getNonZeros());
+  auto push = [&result](int index, double value) {
+    if (value != 0) {
+      result.indices_.push_back(index);
+      result.values_.push_back(value);
+    }
+  };
+  for (int l = 0; l < lines(); l++) {
+    std::size_t a = offsets_[l], aEnd = offsets_[l + 1];
+    std::size_t b = other.offsets_[l], bEnd = other.offsets_[l + 1];
+    while (a < aEnd || b < bEnd) {
+      if (b == bEnd || (a < aEnd && indices_[a] < other.indices_[b])) {
+        push(indices_[a], values_[a]);
+        a++;
+      } else if (a == aEnd || other.indices_[b] < indices_[a]) {
+        push(other.indices_[b], sign * other.values_[b]);
+        b++;
+      } else {
+        push(indices_[a], values_[a] + sign * other.values_[b]);
+        a++;
+        b++;
+      }
+    }
+    result.offsets_[l + 1] = result.indices_.size();
+  }
+  return result;
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix& other) {
+  *this = combined(other, 1);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix& other) {
+  *this = combined(other, -1);
+}
+
+S21SparseMatrix S21SparseMatrix::operator+(
+    const S21SparseMatrix& other) const {
+  return combined(other, 1);
+}
+
+S21SparseMatrix S21SparseMatrix::operator-(
+    const S21SparseMatrix& other) const {
+  return combined(other, -1);
+}
+
+// Every non-zero scales a whole row of the dense operand into a row of the
+// result, which is the SIMD axpy kernel
+S21Matrix S21SparseMatrix::operator*(const S21Matrix& dense) const {
+  if (cols_ != dense.getRows()) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  const int n = dense.getCols();
+  S21Matrix result(rows_, n);
+  // mutable access bumps the version, so it is taken once outside the tasks
+  double* const out = result.getData();
+  const std::ptrdiff_t stride = result.getStride();
+  const auto axpy = s21::Simd().axpy;
+  if (format_ == Format::kCsr) {
+    forLines(rows_, static_cast<double>(getNonZeros()) * n,
+             [&](int begin, int end) {
+               for (int i = begin; i < end; i++) {
+                 double* row = out + i * stride;
+                 for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; k++) {
+                   axpy(row, dense.getMatrix()[indices_[k]], values_[k], n);
+                 }
+               }
+             });
+  } else {
+    for (int j = 0; j < cols_; j++) {
+      const double* source = dense.getMatrix()[j];
+      for (std::size_t k = offsets_[j]; k < offsets_[j + 1]; k++) {
+        axpy(out + indices_[k] * stride, source, values_[k], n);
+      }
+    }
+  }
+  return result;
+}
+
+S21Matrix operator*(const S21Matrix& dense, const S21SparseMatrix& sparse) {
+  if (dense.getCols() != sparse.getRows()) {
+    throw std::invalid_argument("Wrong dimensions for matrix multiplication");
+  }
+  const int m = dense.getRows(), k = dense.getCols();
+  S21Matrix result(m, sparse.getCols());
+  const std::vector<std::size_t>& offsets = sparse.getOffsets();
+  const std::vector<int>& indices = sparse.getIndices();
+  const std::vector<double>& values = sparse.getValues();
+  const bool csr = sparse.getFormat() == S21SparseMatrix::Format::kCsr;
+  // mutable access bumps the version, so it is taken once outside the tasks
+  double* const data = result.getData();
+  const std::ptrdiff_t stride = result.getStride();
+  forLines(m, static_cast<double>(sparse.getNonZeros()) * m,
+           [&](int begin, int end) {
+             for (int i = begin; i < end; i++) {
+               const double* row = dense.getMatrix()[i];
+               double* out = data + i * stride;
+               if (csr) {
+                 // scatter row p of the sparse operand, scaled by D(i, p)
+                 for (int p = 0; p < k; p++) {
+                   for (std::size_t q = offsets[p]; q < offsets[p + 1];
+                        q++) {
+                     out[indices[q]] += row[p] * values[q];
+                   }
+                 }
+               } else {
+                 // gather: C(i, j) is row i of D dotted with column j
+                 for (int j = 0; j < sparse.getCols(); j++) {
+                   double sum = 0;
+                   for (std::size_t q = offsets[j]; q < offsets[j + 1];
+                        q++) {
+                     sum += row[indices[q]] * values[q];
+                   }
+                   out[j] = sum;
+                 }
+               }
+             }
+           });
+  return result;
+}
@@ -0,0 +1,82 @@
+#ifndef S21_SPARSE_MATRIX_H_
+#define S21_SPARSE_MATRIX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Compressed sparse matrix that stores only its non-zeros, in CSR (row by
+// row) or CSC (column by column) form. Entry k of the line l (a row for
+// CSR, a column for CSC) for offsets[l] <= k < offsets[l + 1] has value
+// values[k] at the position indices[k] across the line; indices are
+// sorted within a line. Memory and products scale with the number of
+// non-zeros instead of rows * cols
+class S21SparseMatrix {
+ public:
+  enum class Format { kCsr, kCsc };
+
+  struct Triplet {
+    int row, col;
+    double value;
+  };
+
+  // rows x cols matrix of zeros
+  S21SparseMatrix(int rows, int cols, Format format = Format::kCsr);
+  // From (row, col, value) entries in any order, duplicates are summed
+  S21SparseMatrix(int rows, int cols, const std::vector<Triplet>& triplets,
+                  Format format = Format::kCsr);
+  // Entries of dense with magnitude above threshold
+  explicit S21SparseMatrix(const S21Matrix& dense, double threshold = 0,
+                           Format format = Format::kCsr);
+
+  // accessors
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  Format getFormat() const { return format_; }
+  std::size_t getNonZeros() const { return values_.size(); }
+  const std::vector<std::size_t>& getOffsets() const { return offsets_; }
+  const std::vector<int>& getIndices() const { return indices_; }
+  const std::vector<double>& getValues() const { return values_; }
+
+  // Element (row, col), zero if it is not stored
+  double operator()(int row, int col) const;
+  S21Matrix ToDense() const;
+  // Same matrix in the other layout, O(non-zeros)
+  S21SparseMatrix ToCsr() const;
+  S21SparseMatrix ToCsc() const;
+
+  // matrix operations
+  // The transpose of a CSR matrix is the same arrays read as CSC, so this
+  // only copies them
+  S21SparseMatrix Transpose() const;
+  // y = A * x, x has getCols() values
+  std::vector<double> MulVector(const std::vector<double>& x) const;
+  void SumMatrix(const S21SparseMatrix& other);
+  void SubMatrix(const S21SparseMatrix& other);
+
+  // operators overload
+  S21SparseMatrix operator+(const S21SparseMatrix& other) const;
+  S21SparseMatrix operator-(const S21SparseMatrix& other) const;
+  // Sparse times dense
+  S21Matrix operator*(const S21Matrix& dense) const;
+
+ private:
+  // Number of lines: rows for CSR, columns for CSC
+  int lines() const { return format_ == Format::kCsr ? rows_ : cols_; }
+  // Same non-zeros re-sorted into the other layout
+  S21SparseMatrix converted() const;
+  // this + sign * other, the result keeps this format
+  S21SparseMatrix combined(const S21SparseMatrix& other, double sign) const;
+
+  int rows_, cols_;
+  Format format_;
+  std::vector<std::size_t> offsets_;
+  std::vector<int> indices_;
+  std::vector<double> values_;
+};
+
+// Dense times sparse
+S21Matrix operator*(const S21Matrix& dense, const S21SparseMatrix& sparse);
+
+#endif
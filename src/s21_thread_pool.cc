@@ -0,0 +1,111 @@
+#include "s21_thread_pool.h"
+
+#include <memory>
+
+namespace s21 {
+
+namespace {
+
+// Set while the current thread executes loop iterations
+thread_local bool inParallelFor = false;
+
+int hardwareThreads() {
+  unsigned threads = std::thread::hardware_concurrency();
+  return threads ? static_cast<int>(threads) : 1;
+}
+
+std::mutex defaultPoolMutex;
+std::unique_ptr<ThreadPool> defaultPool;
+
+}  // namespace
+
+ThreadPool::ThreadPool(int threads) {
+  for (int i = 1; i < threads; i++) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+}
+
+void ThreadPool::ParallelFor(int count,
+                             const std::function<void(int)>& task) {
+  if (count <= 0) return;
+  if (workers_.empty() || count == 1 || inParallelFor) {
+    for (int i = 0; i < count; i++) task(i);
+    return;
+  }
+
+  std::lock_guard<std::mutex> submit(submit_);
+  {
+    // late workers of the previous loop may still be reading its state
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    task_ = &task;
+    count_ = count;
+    next_ = 0;
+    error_ = nullptr;
+    generation_++;
+  }
+  wake_.notify_all();
+
+  inParallelFor = true;
+  runTasks();
+  inParallelFor = false;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return active_ == 0; });
+  if (error_) std::rethrow_exception(error_);
+}
+
+void ThreadPool::workerLoop() {
+  inParallelFor = true;
+  std::unique_lock<std::mutex> lock(mutex_);
+  std::uint64_t seen = generation_;
+  for (;;) {
+    wake_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+    if (stop_) return;
+    seen = generation_;
+    active_++;
+    lock.unlock();
+    runTasks();
+    lock.lock();
+    if (--active_ == 0) done_.notify_all();
+  }
+}
+
+void ThreadPool::runTasks() {
+  for (int i = next_++; i < count_; i = next_++) {
+    try {
+      (*task_)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+  }
+}
+
+ThreadPool& DefaultThreadPool() {
+  std::lock_guard<std::mutex> lock(defaultPoolMutex);
+  if (!defaultPool) {
+    defaultPool = std::make_unique<ThreadPool>(hardwareThreads());
+  }
+  return *defaultPool;
+}
+
+void SetThreadCount(int threads) {
+  std::lock_guard<std::mutex> lock(defaultPoolMutex);
+  defaultPool.reset();
+  defaultPool =
+      std::make_unique<ThreadPool>(threads > 0 ? threads : hardwareThreads());
+}
+
+int ThreadCount() { return DefaultThreadPool().getThreads(); }
+
+}  // namespace s21
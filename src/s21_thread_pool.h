@@ -0,0 +1,63 @@
+#ifndef S21_THREAD_POOL_H_
+#define S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// Fixed set of worker threads running index-parallel loops. The calling
+// thread takes part in every loop, so a pool of n threads starts n - 1
+// workers. Loops submitted from inside a running loop execute serially
+class ThreadPool {
+ public:
+  explicit ThreadPool(int threads);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Threads taking part in a loop, the caller included
+  int getThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Runs task(i) for every i in [0, count) and returns once all calls have
+  // finished. The first exception thrown by a task is rethrown here
+  void ParallelFor(int count, const std::function<void(int)>& task);
+
+ private:
+  void workerLoop();
+  void runTasks();
+
+  std::vector<std::thread> workers_;
+  std::mutex submit_;  // one loop at a time
+  std::mutex mutex_;   // guards everything below except next_
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(int)>* task_ = nullptr;
+  int count_ = 0;
+  std::atomic<int> next_{0};
+  int active_ = 0;  // workers currently inside runTasks
+  std::uint64_t generation_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+};
+
+// Library-owned pool used by the parallel kernels, created on first use
+// with std::thread::hardware_concurrency() threads
+ThreadPool& DefaultThreadPool();
+
+// Recreates the library pool with the given number of threads (0 means
+// hardware concurrency). Must not be called while kernels are running
+void SetThreadCount(int threads);
+
+// Number of threads of the library pool
+int ThreadCount();
+
+}  // namespace s21
+
+#endif
@@ -1,8 +1,28 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <iostream>
-
+#include <sstream>
+#include <vector>
+
+#include "s21_cholesky_solver.h"
+#include "s21_fixed_matrix.h"
+#include "s21_lu_solver.h"
+#include "s21_matrix_arena.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_expr.h"
+#include "s21_matrix_io.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_strassen.h"
+#include "s21_matrix_text.h"
+#include "s21_refined_solver.h"
+#include "s21_sparse_matrix.h"
+#include "s21_thread_pool.h"
 
 TEST(CreateMatrix, CreateMatrix_DefaultArgs) {
   S21Matrix* matrix = new S21Matrix();
@@ -68,6 +88,79 @@ TEST(MoveMatrix, MoveMatrix_when_they_are_different_are_you_ok) {
   // std::cout << '\n' << temp.getRows() << ' ' << temp.getCols() << '\n';
 }
 
+TEST(Storage, Storage_contiguous_and_aligned) {
+  S21Matrix matrix(7, 13);
+  matrix.setValue();
+
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.getData()) %
+                S21Matrix::kAlignment,
+            0u);
+  for (int i = 0; i < matrix.getRows(); i++) {
+    EXPECT_EQ(matrix.getMatrix()[i], matrix.getData() + i * matrix.getStride());
+  }
+}
+
+TEST(Storage, Storage_resize_keeps_values_and_fills_zeros) {
+  S21Matrix matrix(2, 2);
+  double values1[] = {1, 2, 3, 4};
+  matrix.setGivenValues(values1, sizeof(values1) / sizeof(values1[0]));
+
+  matrix.setCols(3);
+  matrix.setRows(3);
+  S21Matrix control(3, 3);
+  double values2[] = {1, 2, 0, 3, 4, 0, 0, 0, 0};
+  control.setGivenValues(values2, sizeof(values2) / sizeof(values2[0]));
+  EXPECT_TRUE(matrix.EqMatrix(control));
+
+  matrix.setRows(1);
+  EXPECT_EQ(matrix.getRows(), 1);
+  EXPECT_DOUBLE_EQ(matrix(0, 1), 2);
+  EXPECT_ANY_THROW(matrix.setCols(0));
+}
+
+TEST(MoveMatrix, MoveAssign_takes_buffer_test) {
+  S21Matrix initial(3, 4);
+  initial.setValue();
+  S21Matrix copied(initial);
+  const double* buffer = initial.getData();
+
+  S21Matrix target(2, 2);
+  target = std::move(initial);
+  EXPECT_EQ(target.getData(), buffer);
+  EXPECT_TRUE(initial.getMatrix() == nullptr);
+  EXPECT_TRUE(target.EqMatrix(copied));
+
+  initial = target;
+  EXPECT_TRUE(initial.EqMatrix(copied));
+}
+
+TEST(MoveMatrix, MoveMatrix_operators_reuse_expiring_buffer_test) {
+  S21Matrix a(3, 3), b(3, 3), c(3, 3), d(3, 3);
+  a.setValue();
+  b.setValue();
+  c.setValue();
+  d.setValue();
+
+  S21Matrix control(a);
+  control += b;
+  control += c;
+  control -= d;
+  control *= 2.0;
+
+  S21Matrix sum = a + b;
+  const double* buffer = sum.getData();
+  S21Matrix result = (std::move(sum) + c - d) * 2.0;
+  EXPECT_EQ(result.getData(), buffer);
+  EXPECT_TRUE(result.EqMatrix(control));
+
+  S21Matrix rhs = c - d;
+  buffer = rhs.getData();
+  S21Matrix result2 = a - std::move(rhs);
+  EXPECT_EQ(result2.getData(), buffer);
+  EXPECT_TRUE((result2 + c - d).EqMatrix(a));
+  EXPECT_ANY_THROW(a - S21Matrix(2, 3));
+}
+
 TEST(EqMatrix, EqMatrix_True) {
   S21Matrix matrix1(8, 9);
   S21Matrix matrix2(8, 9);
@@ -104,6 +197,42 @@ TEST(EqMatrix, EqMatrix_with_minus_test) {
   EXPECT_TRUE(matrix1.EqMatrix(matrix2));
 }
 
+TEST(Simd, Simd_every_level_matches_scalar_test) {
+  const s21::SimdLevel levels[] = {s21::SimdLevel::kScalar,
+                                   s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                                   s21::SimdLevel::kAvx512};
+  S21Matrix matrix1(7, 11), matrix2(7, 11);
+  matrix1.setValue();
+  matrix2.setValue();
+  S21Matrix sum(7, 11), difference(7, 11), scaled(7, 11);
+  for (int i = 0; i < 7; i++) {
+    for (int j = 0; j < 11; j++) {
+      sum(i, j) = matrix1(i, j) + matrix2(i, j);
+      difference(i, j) = matrix1(i, j) - matrix2(i, j);
+      scaled(i, j) = matrix1(i, j) * -1.5;
+    }
+  }
+
+  for (s21::SimdLevel level : levels) {
+    s21::SetSimdLevel(level);
+    EXPECT_TRUE((matrix1 + matrix2).EqMatrix(sum));
+    EXPECT_TRUE((matrix1 - matrix2).EqMatrix(difference));
+    EXPECT_TRUE((matrix1 * -1.5).EqMatrix(scaled));
+    EXPECT_TRUE((matrix1 * matrix2.Transpose())
+                    .EqMatrix(S21Matrix(matrix1) *= matrix2.Transpose()));
+    S21Matrix axpy(matrix1);
+    s21::Simd().axpy(axpy.getData(), matrix2.getData(), -1.5, axpy.getSize());
+    EXPECT_TRUE(axpy.EqMatrix(matrix1 + matrix2 * -1.5));
+    for (int k = 0; k < 7 * 11; k++) {
+      S21Matrix other(matrix1);
+      other(k / 11, k % 11) += 1e-6;
+      EXPECT_FALSE(matrix1.EqMatrix(other));
+    }
+  }
+  s21::SetSimdLevel(s21::DetectedSimdLevel());
+  EXPECT_EQ(s21::ActiveSimdLevel(), s21::DetectedSimdLevel());
+}
+
 TEST(SumMatrix, SumMatrix_test) {
   S21Matrix matrix1(2, 3);
   S21Matrix matrix2(2, 3);
@@ -264,6 +393,1013 @@ TEST(MulMatrix, MulMatrix_with_wrong_dims) {
   EXPECT_ANY_THROW(matrix1.MulMatrix(matrix2));
 }
 
+TEST(MulMatrix, MulMatrix_blocked_odd_sizes_test) {
+  S21Matrix matrix1(101, 300);
+  S21Matrix matrix2(300, 67);
+  matrix1.setValue();
+  matrix2.setValue();
+
+  S21Matrix control(101, 67);
+  for (int i = 0; i < control.getRows(); i++) {
+    for (int j = 0; j < control.getCols(); j++) {
+      double sum = 0;
+      for (int k = 0; k < matrix1.getCols(); k++) {
+        sum += matrix1(i, k) * matrix2(k, j);
+      }
+      control(i, j) = sum;
+    }
+  }
+  S21Matrix result = matrix1 * matrix2;
+  EXPECT_TRUE(result.EqMatrix(control));
+  matrix1 *= matrix2;
+  EXPECT_TRUE(matrix1.EqMatrix(control));
+}
+
+TEST(MulMatrix, MulMatrix_parallel_test) {
+  S21Matrix matrix1(300, 250);
+  S21Matrix matrix2(250, 410);
+  matrix1.setValue();
+  matrix2.setValue();
+
+  s21::SetThreadCount(1);
+  S21Matrix control = matrix1 * matrix2;
+  s21::SetThreadCount(4);
+  EXPECT_EQ(s21::ThreadCount(), 4);
+  S21Matrix result = matrix1 * matrix2;
+  s21::SetThreadCount(0);
+
+  EXPECT_TRUE(result.EqMatrix(control));
+}
+
+TEST(MulMatrix, MulMatrix_strassen_test) {
+  S21Matrix matrix1(203, 157);
+  S21Matrix matrix2(157, 181);
+  matrix1.setValue();
+  matrix2.setValue();
+  S21Matrix control = matrix1 * matrix2;
+
+  // odd sizes at every level of a deep recursion
+  S21Matrix result = control * 2.0;
+  s21::Strassen(203, 181, 157, matrix1.getData(), matrix1.getStride(),
+                matrix2.getData(), matrix2.getStride(), result.getData(),
+                result.getStride(), 5);
+  EXPECT_TRUE(result.EqMatrix(control));
+  EXPECT_EQ(s21::StrassenWorkspace(203, 181, 157, 5),
+            101u * 90 + 78u * 90 + 50u * 45 + 39u * 45 + 25u * 22 + 19u * 22 +
+                12u * 11 + 9u * 11 + 6u * 5 + 4u * 5);
+  EXPECT_EQ(s21::StrassenWorkspace(203, 181, 157, 200), 0u);
+
+  EXPECT_EQ(s21::StrassenCrossover(), 0);
+  s21::SetStrassenCrossover(64);
+  EXPECT_EQ(s21::StrassenCrossover(), 64);
+  result = matrix1 * matrix2;
+  matrix1 *= matrix2;
+  s21::SetStrassenCrossover(0);
+  EXPECT_TRUE(result.EqMatrix(control));
+  EXPECT_TRUE(matrix1.EqMatrix(control));
+}
+
+TEST(MatrixView, MatrixView_transposed_product_test) {
+  S21Matrix matrix1(150, 90);
+  S21Matrix matrix2(150, 70);
+  matrix1.setValue();
+  matrix2.setValue();
+
+  S21Matrix control = matrix1.Transpose() * matrix2;
+  S21Matrix result = matrix1.TransposeView() * matrix2;
+  EXPECT_TRUE(result.EqMatrix(control));
+
+  S21Matrix small = matrix2.Transpose();
+  S21Matrix both = matrix1.TransposeView() * small.TransposeView();
+  EXPECT_TRUE(both.EqMatrix(control));
+  EXPECT_TRUE(small.EqMatrix(matrix2.TransposeView()));
+
+  control = small * matrix1;
+  small.MulMatrix(matrix1.View());
+  EXPECT_TRUE(small.EqMatrix(control));
+  EXPECT_ANY_THROW(matrix1.TransposeView() * small.View());
+}
+
+TEST(MatrixView, MatrixView_elementwise_test) {
+  S21Matrix matrix(3, 3);
+  double values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  matrix.setGivenValues(values, 9);
+
+  S21ConstMatrixView view = matrix.TransposeView();
+  EXPECT_TRUE(view.isTransposed());
+  EXPECT_DOUBLE_EQ(view(0, 2), 7);
+  EXPECT_TRUE(matrix.Transpose().EqMatrix(view));
+  EXPECT_FALSE(matrix.EqMatrix(view));
+  EXPECT_TRUE(S21Matrix(view).EqMatrix(matrix.Transpose()));
+
+  // A += A^T reads the buffer it writes
+  S21Matrix symmetric(matrix);
+  symmetric.SumMatrix(symmetric.TransposeView());
+  double sums[] = {2, 6, 10, 6, 10, 14, 10, 14, 18};
+  S21Matrix control(3, 3);
+  control.setGivenValues(sums, 9);
+  EXPECT_TRUE(symmetric.EqMatrix(control));
+
+  symmetric.SubMatrix(matrix.TransposeView());
+  EXPECT_TRUE(symmetric.EqMatrix(matrix));
+
+  // every other element of a row, a view that is neither layout
+  S21Matrix wide(2, 6);
+  double wideValues[] = {1, 0, 2, 0, 3, 0, 4, 0, 5, 0, 6, 0};
+  wide.setGivenValues(wideValues, 12);
+  S21ConstMatrixView strided(wide.getData(), 3, 2, 2, 6);
+  S21Matrix expected(3, 2);
+  double expectedValues[] = {1, 4, 2, 5, 3, 6};
+  expected.setGivenValues(expectedValues, 6);
+  EXPECT_TRUE(expected.EqMatrix(strided));
+  EXPECT_ANY_THROW(matrix.SumMatrix(strided));
+}
+
+TEST(MatrixView, MatrixView_blocks_write_in_place_test) {
+  S21Matrix matrix(4, 5);
+  double values[] = {1,  2,  3,  4,  5,  6,  7,  8,  9,  10,
+                     11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+  matrix.setGivenValues(values, 20);
+
+  S21MatrixView block = matrix.Block(1, 2, 2, 3);
+  EXPECT_DOUBLE_EQ(block(0, 0), 8);
+  EXPECT_DOUBLE_EQ(block(1, 2), 15);
+  EXPECT_DOUBLE_EQ(matrix.Row(3)(0, 4), 20);
+  EXPECT_DOUBLE_EQ(matrix.Col(1)(2, 0), 12);
+
+  S21Matrix ones(2, 3);
+  double onesValues[] = {1, 1, 1, 1, 1, 1};
+  ones.setGivenValues(onesValues, 6);
+  s21::AddView(block, ones);
+  s21::ScaleView(matrix.Col(0), 0);
+  EXPECT_DOUBLE_EQ(matrix(1, 2), 9);
+  EXPECT_DOUBLE_EQ(matrix(2, 4), 16);
+  EXPECT_DOUBLE_EQ(matrix(2, 1), 12);
+  EXPECT_DOUBLE_EQ(matrix(3, 0), 0);
+
+  // C[0:2, 0:2] += A[0:2, 2:5] * B^T with B the rows 2:4 of the same matrix
+  S21Matrix control =
+      S21Matrix(matrix.Block(0, 0, 2, 2)) +
+      S21Matrix(matrix.Block(0, 2, 2, 3)) *
+          S21Matrix(matrix.Block(2, 2, 2, 3)).Transpose();
+  s21::GemmView(matrix.Block(0, 0, 2, 2), matrix.Block(0, 2, 2, 3),
+                matrix.Block(2, 2, 2, 3).Transposed());
+  EXPECT_TRUE(control.EqMatrix(matrix.Block(0, 0, 2, 2)));
+
+  EXPECT_ANY_THROW(matrix.Block(3, 0, 2, 1));
+  EXPECT_ANY_THROW(matrix.Block(-1, 0, 1, 1));
+  EXPECT_ANY_THROW(matrix.Row(4));
+  EXPECT_ANY_THROW(s21::AddView(block, matrix.View()));
+}
+
+TEST(MatrixView, MatrixView_minor_test) {
+  S21Matrix matrix(3, 4);
+  double values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  matrix.setGivenValues(values, 12);
+
+  S21ConstMinorView minor = matrix.Minor(1, 2);
+  EXPECT_EQ(minor.getRows(), 2);
+  EXPECT_EQ(minor.getCols(), 3);
+  EXPECT_DOUBLE_EQ(minor(1, 2), 12);
+  EXPECT_DOUBLE_EQ(minor(0, 1), 2);
+
+  S21Matrix control(2, 3);
+  double controlValues[] = {1, 2, 4, 9, 10, 12};
+  control.setGivenValues(controlValues, 6);
+  EXPECT_TRUE(S21Matrix(minor).EqMatrix(control));
+  EXPECT_TRUE(matrix.cut_matrix(1, 2).EqMatrix(control));
+  EXPECT_TRUE(
+      S21Matrix(matrix.Minor(0, 0)).EqMatrix(matrix.Block(1, 1, 2, 3)));
+
+  S21MinorView writable = matrix.Minor(2, 3);
+  writable(1, 1) = -6;
+  EXPECT_DOUBLE_EQ(matrix(1, 1), -6);
+
+  EXPECT_ANY_THROW(matrix.Minor(3, 0));
+  EXPECT_ANY_THROW(matrix.Minor(0, -1));
+  S21Matrix row(1, 3);
+  EXPECT_ANY_THROW(row.Minor(0, 0));
+}
+
+TEST(Arena, Arena_recycles_buffers_test) {
+  S21Matrix outlives(2, 2);
+  {
+    s21::ScopedArena scope;
+    EXPECT_EQ(s21::CurrentArena(), &scope.getArena());
+    const double* first = nullptr;
+    {
+      S21Matrix temporary(10, 10);
+      temporary.setValue();
+      first = temporary.getData();
+    }
+    EXPECT_GE(scope.getArena().getCachedBytes(), 800u);
+
+    // same size class, same buffer, and zero filled again
+    S21Matrix reused(9, 11);
+    EXPECT_EQ(reused.getData(), first);
+    EXPECT_EQ(scope.getArena().getCachedBytes(), 0u);
+    EXPECT_DOUBLE_EQ(reused(8, 10), 0);
+
+    S21Matrix a(30, 30);
+    a.setValue();
+    for (int i = 0; i < 30; i++) a(i, i) += 30;
+    S21Matrix identity(30, 30);
+    for (int i = 0; i < 30; i++) identity(i, i) = 1;
+    S21Matrix inverse = a.InverseMatrix();
+    EXPECT_TRUE((a * inverse).EqMatrix(identity));
+    outlives = std::move(inverse);
+  }
+  EXPECT_EQ(s21::CurrentArena(), nullptr);
+  EXPECT_EQ(outlives.getRows(), 30);
+  outlives.MulNumber(2);
+}
+
+TEST(Arena, Arena_nesting_and_limits_test) {
+  s21::Arena shared(0);
+  {
+    s21::ScopedArena outer(shared);
+    {
+      s21::ScopedArena inner;
+      { S21Matrix temporary(4, 4); }
+      EXPECT_GT(inner.getArena().getCachedBytes(), 0u);
+    }
+    EXPECT_EQ(s21::CurrentArena(), &shared);
+    { S21Matrix temporary(4, 4); }
+    // no room: the buffer went back to the heap
+    EXPECT_EQ(shared.getCachedBytes(), 0u);
+  }
+
+  s21::Arena big;
+  {
+    s21::ScopedArena scope(big);
+    { S21Matrix huge(1024, 1024); }
+    // above the largest size class buffers are never cached
+    EXPECT_EQ(big.getCachedBytes(), 0u);
+    { s21::ArenaBuffer<int> scratch(100); }
+  }
+  EXPECT_EQ(big.getCachedBytes(), 512u);
+  big.Release();
+  EXPECT_EQ(big.getCachedBytes(), 0u);
+}
+
+TEST(Arena, Arena_size_overflow_test) {
+  // 2147352580 * 1073807362 doubles wrap around to 64 bytes
+  EXPECT_THROW(S21Matrix(2147352580, 1073807362), std::bad_alloc);
+  EXPECT_THROW(S21MatrixBatch(1 << 20, 1 << 30, 1 << 30), std::bad_alloc);
+  EXPECT_THROW(s21::ArenaBuffer<double>(SIZE_MAX / 4), std::bad_alloc);
+  EXPECT_THROW(s21::AllocateBuffer(SIZE_MAX - 8), std::bad_alloc);
+}
+
+TEST(MatrixFile, MatrixFile_save_load_map_test) {
+  std::string path = testing::TempDir() + "s21_matrix_file_test.bin";
+  S21Matrix matrix(37, 53);
+  matrix.setValue();
+
+  s21::Save(matrix, path);
+  S21Matrix loaded = s21::Load(path);
+  EXPECT_EQ(loaded.getRows(), 37);
+  EXPECT_EQ(loaded.getCols(), 53);
+  EXPECT_TRUE(loaded == matrix);
+
+  {
+    s21::MappedMatrix mapped(path);
+    EXPECT_EQ(mapped.getRows(), 37);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.View().getData()) %
+                  S21Matrix::kAlignment,
+              0u);
+    EXPECT_TRUE(matrix.EqMatrix(mapped));
+    S21Matrix product = mapped.View() * matrix.TransposeView();
+    EXPECT_TRUE(product.EqMatrix(matrix * matrix.Transpose()));
+    s21::MappedMatrix moved(std::move(mapped));
+    EXPECT_TRUE(S21Matrix(moved.View()).EqMatrix(matrix));
+  }
+
+  s21::Save(matrix.TransposeView(), path);
+  EXPECT_TRUE(s21::Load(path).EqMatrix(matrix.Transpose()));
+  std::remove(path.c_str());
+}
+
+TEST(MatrixFile, MatrixFile_foreign_and_broken_files_test) {
+  std::string path = testing::TempDir() + "s21_matrix_file_test.bin";
+  auto swap64 = [](std::uint64_t value) {
+    std::uint64_t result = 0;
+    for (int i = 0; i < 8; i++) result = result << 8 | (value >> 8 * i & 0xff);
+    return result;
+  };
+  auto swap32 = [](std::uint32_t value) {
+    return (value >> 24) | (value >> 8 & 0xff00) | (value << 8 & 0xff0000) |
+           (value << 24);
+  };
+
+  // the same 2x2 matrix as written by a machine of the other endianness
+  s21::FileHeader header = {};
+  std::memcpy(header.magic, s21::kFileMagic, sizeof(header.magic));
+  header.version = swap32(s21::kFileVersion);
+  header.dtype = swap32(s21::kFileFloat64);
+  header.byteOrder = swap64(s21::kFileByteOrder);
+  header.payloadOffset = swap64(s21::kFileHeaderSize);
+  header.rows = static_cast<std::int64_t>(swap64(2));
+  header.cols = static_cast<std::int64_t>(swap64(2));
+  double values[] = {1.5, -2, 3.25, 4};
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (double value : values) {
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      bits = swap64(bits);
+      file.write(reinterpret_cast<const char*>(&bits), sizeof(bits));
+    }
+  }
+  S21Matrix control(2, 2);
+  control.setGivenValues(values, 4);
+  EXPECT_TRUE(s21::Load(path).EqMatrix(control));
+  EXPECT_THROW(s21::MappedMatrix mapped(path), std::invalid_argument);
+
+  // payload cut short
+  s21::Save(control, path);
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::in);
+    header.rows = 3;
+    header.cols = 2;
+    file.seekp(offsetof(s21::FileHeader, rows));
+    file.write(reinterpret_cast<const char*>(&header.rows), 16);
+  }
+  EXPECT_THROW(s21::Load(path), std::invalid_argument);
+  EXPECT_THROW(s21::MappedMatrix mapped(path), std::invalid_argument);
+
+  // dimensions whose byte count wraps around to the 64 bytes on disk
+  s21::Save(S21Matrix(2, 4), path);
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::in);
+    header.rows = 2147352580;
+    header.cols = 1073807362;
+    file.seekp(offsetof(s21::FileHeader, rows));
+    file.write(reinterpret_cast<const char*>(&header.rows), 16);
+  }
+  EXPECT_THROW(s21::Load(path), std::invalid_argument);
+  EXPECT_THROW(s21::MappedMatrix mapped(path), std::invalid_argument);
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "1 2\n3 4\n";
+  }
+  EXPECT_THROW(s21::Load(path), std::invalid_argument);
+  std::remove(path.c_str());
+  EXPECT_THROW(s21::Load(path), std::runtime_error);
+  EXPECT_THROW(s21::MappedMatrix mapped(path), std::runtime_error);
+}
+
+TEST(MatrixText, MatrixText_parse_test) {
+  std::istringstream text(
+      "\n  1, 2.5 ,-3\r\n4;+5e1\t6\n\n , \n7 8 -9.25e-1");
+  S21Matrix matrix = s21::ReadText(text);
+  S21Matrix control(3, 3);
+  double values[] = {1, 2.5, -3, 4, 50, 6, 7, 8, -0.925};
+  control.setGivenValues(values, 9);
+  EXPECT_TRUE(matrix.EqMatrix(control));
+
+  // chunks much shorter than a line
+  text.clear();
+  text.seekg(0);
+  s21::TextOptions options;
+  options.chunkBytes = 3;
+  EXPECT_TRUE(s21::ReadText(text, options).EqMatrix(control));
+
+  std::istringstream ragged("1 2 3\n4 5\n");
+  EXPECT_THROW(s21::ReadText(ragged), std::invalid_argument);
+  std::istringstream longer("1 2\n4 5 6\n");
+  EXPECT_THROW(s21::ReadText(longer), std::invalid_argument);
+  std::istringstream garbage("1 2\n4 x\n");
+  EXPECT_THROW(s21::ReadText(garbage), std::invalid_argument);
+  std::istringstream glued("1 2\n4 5-\n");
+  EXPECT_THROW(s21::ReadText(glued), std::invalid_argument);
+  std::istringstream empty(" \n\n");
+  EXPECT_THROW(s21::ReadText(empty), std::invalid_argument);
+  EXPECT_THROW(s21::ReadText(testing::TempDir() + "no_such_matrix.csv"),
+               std::runtime_error);
+}
+
+TEST(MatrixText, MatrixText_round_trip_parallel_test) {
+  S21Matrix matrix(301, 17);
+  matrix.setValue();
+  matrix(0, 0) = -1e-300;
+  matrix(300, 16) = 123456789.125;
+
+  std::stringstream text;
+  s21::WriteText(text, matrix);
+  std::string written = text.str();
+  EXPECT_EQ(std::count(written.begin(), written.end(), '\n'), 301);
+
+  S21Matrix serial = s21::ReadText(text);
+  EXPECT_EQ(std::memcmp(serial.getData(), matrix.getData(),
+                        matrix.getSize() * sizeof(double)),
+            0);
+
+  s21::SetThreadCount(4);
+  s21::TextOptions options;
+  options.parallel = true;
+  options.chunkBytes = 1000;
+  std::istringstream again(written);
+  S21Matrix parallel = s21::ReadText(again, options);
+  s21::SetThreadCount(0);
+  EXPECT_EQ(std::memcmp(parallel.getData(), matrix.getData(),
+                        matrix.getSize() * sizeof(double)),
+            0);
+
+  std::ostringstream transposed;
+  s21::WriteText(transposed, matrix.Block(0, 0, 2, 2).Transposed(), ' ');
+  std::istringstream back(transposed.str());
+  EXPECT_TRUE(s21::ReadText(back).EqMatrix(
+      matrix.Block(0, 0, 2, 2).Transposed()));
+}
+
+TEST(MatrixBatch, MatrixBatch_matches_single_matrices_test) {
+  for (int n = 1; n <= 8; n++) {
+    const int count = 13;
+    S21MatrixBatch a(count, n, n), b(count, n, n);
+    std::vector<S21Matrix> singleA, singleB;
+    for (int m = 0; m < count; m++) {
+      S21Matrix x(n, n), y(n, n);
+      x.setValue();
+      y.setValue();
+      for (int i = 0; i < n; i++) x(i, i) += 1;
+      a.Set(m, x);
+      b.Set(m, y);
+      singleA.push_back(x);
+      singleB.push_back(y);
+    }
+
+    std::vector<double> det = a.Determinant();
+    S21MatrixBatch inverse = a.InverseMatrix();
+    S21MatrixBatch product = a * b;
+    S21MatrixBatch transposed = b.Transpose();
+    ASSERT_EQ(det.size(), static_cast<std::size_t>(count));
+    for (int m = 0; m < count; m++) {
+      EXPECT_NEAR(det[m], singleA[m].Determinant(), 1e-9);
+      EXPECT_TRUE(inverse.Get(m).EqMatrix(singleA[m].InverseMatrix()));
+      EXPECT_TRUE(product.Get(m).EqMatrix(singleA[m] * singleB[m]));
+      EXPECT_TRUE(transposed.Get(m).EqMatrix(singleB[m].Transpose()));
+    }
+    a.MulMatrix(inverse);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        EXPECT_NEAR(a(count - 1, i, j), i == j, 1e-9);
+      }
+    }
+  }
+}
+
+TEST(MatrixBatch, MatrixBatch_errors_test) {
+  S21MatrixBatch batch(3, 3, 3);
+  for (int m = 0; m < 3; m++) {
+    for (int i = 0; i < 3; i++) batch(m, i, i) = m + 1;
+  }
+  std::vector<double> det = batch.Determinant();
+  EXPECT_DOUBLE_EQ(det[0], 1);
+  EXPECT_DOUBLE_EQ(det[2], 27);
+  batch(1, 2, 2) = 0;
+  EXPECT_DOUBLE_EQ(batch.Determinant()[1], 0);
+  EXPECT_THROW(batch.InverseMatrix(), std::invalid_argument);
+
+  // rows swapped in one lane only
+  S21Matrix swapped(3, 3);
+  double values[] = {0, 1, 0, 1, 0, 0, 0, 0, 2};
+  swapped.setGivenValues(values, 9);
+  batch.Set(1, swapped);
+  EXPECT_DOUBLE_EQ(batch.Determinant()[1], -2);
+  EXPECT_TRUE(batch.InverseMatrix().Get(1).EqMatrix(swapped.InverseMatrix()));
+
+  S21MatrixBatch wide(3, 2, 3);
+  EXPECT_THROW(wide.Determinant(), std::invalid_argument);
+  EXPECT_THROW(wide.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(wide * wide, std::invalid_argument);
+  EXPECT_THROW(batch * S21MatrixBatch(4, 3, 3), std::invalid_argument);
+  EXPECT_EQ((wide * batch).getCols(), 3);
+  EXPECT_THROW(wide.Set(0, swapped), std::invalid_argument);
+  EXPECT_THROW(batch.Get(3), std::invalid_argument);
+  EXPECT_THROW(batch(0, 3, 0), std::invalid_argument);
+  EXPECT_THROW(S21MatrixBatch(0, 2, 2), std::invalid_argument);
+}
+
+TEST(SparseMatrix, SparseMatrix_build_and_convert_test) {
+  using Format = S21SparseMatrix::Format;
+  S21SparseMatrix sparse(3, 4, {{2, 1, 5}, {0, 3, 1}, {0, 0, 2}, {2, 1, -1},
+                               {1, 2, 3}, {1, 0, 4}, {1, 0, -4}});
+  EXPECT_EQ(sparse.getNonZeros(), 4);
+  EXPECT_DOUBLE_EQ(sparse(2, 1), 4);
+  EXPECT_DOUBLE_EQ(sparse(1, 0), 0);
+  EXPECT_EQ(sparse.getOffsets(), (std::vector<std::size_t>{0, 2, 3, 4}));
+  EXPECT_EQ(sparse.getIndices(), (std::vector<int>{0, 3, 2, 1}));
+
+  S21Matrix dense = sparse.ToDense();
+  double values[] = {2, 0, 0, 1, 0, 0, 3, 0, 0, 4, 0, 0};
+  S21Matrix control(3, 4);
+  control.setGivenValues(values, 12);
+  EXPECT_TRUE(dense.EqMatrix(control));
+
+  S21SparseMatrix csc = sparse.ToCsc();
+  EXPECT_EQ(csc.getFormat(), Format::kCsc);
+  EXPECT_EQ(csc.getOffsets(), (std::vector<std::size_t>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(csc.getIndices(), (std::vector<int>{0, 2, 1, 0}));
+  EXPECT_TRUE(csc.ToDense().EqMatrix(control));
+  EXPECT_EQ(csc.ToCsr().getValues(), sparse.getValues());
+  EXPECT_TRUE(S21SparseMatrix(control, 0, Format::kCsc).ToDense().EqMatrix(
+      control));
+  EXPECT_EQ(S21SparseMatrix(control, 2.5).getNonZeros(), 2);
+
+  S21SparseMatrix transposed = sparse.Transpose();
+  EXPECT_EQ(transposed.getRows(), 4);
+  EXPECT_EQ(transposed.getFormat(), Format::kCsc);
+  EXPECT_TRUE(transposed.ToDense().EqMatrix(control.Transpose()));
+
+  S21SparseMatrix sum = sparse + csc;
+  EXPECT_TRUE(sum.ToDense().EqMatrix(control * 2));
+  EXPECT_EQ((sparse - csc).getNonZeros(), 0);
+  sum.SubMatrix(sparse);
+  EXPECT_TRUE(sum.ToDense().EqMatrix(control));
+
+  EXPECT_THROW(S21SparseMatrix(0, 2), std::invalid_argument);
+  EXPECT_THROW(S21SparseMatrix(2, 2, {{2, 0, 1}}), std::invalid_argument);
+  EXPECT_THROW(S21SparseMatrix(2, 2, {{0, -1, 1}}), std::invalid_argument);
+  EXPECT_THROW(sparse(3, 0), std::invalid_argument);
+  EXPECT_THROW(sparse + transposed, std::invalid_argument);
+}
+
+TEST(SparseMatrix, SparseMatrix_products_test) {
+  using Format = S21SparseMatrix::Format;
+  const int n = 300;
+  std::vector<S21SparseMatrix::Triplet> triplets;
+  for (int i = 0; i < n; i++) {
+    for (int j = i % 7; j < n; j += 7 + i % 5) {
+      triplets.push_back({i, j, (i * 31 + j * 17) % 13 - 6.5});
+    }
+  }
+  S21SparseMatrix csr(n, n, triplets);
+  S21SparseMatrix csc(n, n, triplets, Format::kCsc);
+  S21Matrix a = csr.ToDense();
+  S21Matrix b(n, 8);
+  std::vector<double> x(n);
+  for (int i = 0; i < n; i++) {
+    x[i] = (i % 11) - 5;
+    for (int j = 0; j < 8; j++) b(i, j) = (i + 3 * j) % 9 - 4.0;
+  }
+
+  S21Matrix column(n, 1);
+  for (int i = 0; i < n; i++) column(i, 0) = x[i];
+  S21Matrix expected = a * column;
+  for (const S21SparseMatrix* sparse : {&csr, &csc}) {
+    std::vector<double> y = sparse->MulVector(x);
+    for (int i = 0; i < n; i++) EXPECT_NEAR(y[i], expected(i, 0), 1e-9);
+    EXPECT_TRUE((*sparse * b).EqMatrix(a * b));
+    EXPECT_TRUE((b.Transpose() * *sparse).EqMatrix(b.Transpose() * a));
+  }
+
+  EXPECT_THROW(csr.MulVector(std::vector<double>(n - 1)),
+               std::invalid_argument);
+  EXPECT_THROW(csr * b.Transpose(), std::invalid_argument);
+  EXPECT_THROW(b * csc, std::invalid_argument);
+
+  // a zero times an infinite stored value is NaN in both layouts, as in
+  // the dense product
+  S21SparseMatrix infinite(2, 2, {{0, 1, INFINITY}, {1, 0, 1}});
+  S21Matrix zero(1, 2);
+  for (const S21SparseMatrix& sparse : {infinite, infinite.ToCsc()}) {
+    S21Matrix product = zero * sparse;
+    EXPECT_TRUE(std::isnan(product(0, 1)));
+    EXPECT_EQ(product(0, 0), 0);
+  }
+}
+
+TEST(SparseMatrix, SparseMatrix_parallel_products_test) {
+  // large enough for the products to be split across the pool
+  const int n = 600;
+  std::vector<S21SparseMatrix::Triplet> triplets;
+  for (int i = 0; i < n; i++) {
+    for (int j = i % 5; j < n; j += 5 + i % 3) {
+      triplets.push_back({i, j, (i * 7 + j) % 11 - 5.0});
+    }
+  }
+  S21SparseMatrix csr(n, n, triplets);
+  S21Matrix a = csr.ToDense();
+  S21Matrix b(n, 64);
+  b.setValue();
+  s21::SetThreadCount(4);
+  S21Matrix right = csr * b;
+  S21Matrix left = b.Transpose() * csr;
+  s21::SetThreadCount(0);
+  EXPECT_TRUE(right.EqMatrix(a * b));
+  EXPECT_TRUE(left.EqMatrix(b.Transpose() * a));
+}
+
+TEST(MatrixElementType, MatrixElementType_float_test) {
+  S21Matrix source(70, 300);
+  S21Matrix other(300, 90);
+  source.setValue();
+  other.setValue();
+  S21FloatMatrix a(source);
+  S21FloatMatrix b(other);
+  EXPECT_FLOAT_EQ(a(3, 4), static_cast<float>(source(3, 4)));
+
+  S21FloatMatrix sum = a + a * 2.0f;
+  S21Matrix widened(sum);
+  for (int j = 0; j < 300; j++) {
+    EXPECT_NEAR(widened(5, j), 3 * source(5, j), 1e-5);
+  }
+
+  // packed float product with partial edge tiles, at the detected SIMD
+  // level and at the SSE2 baseline, against the double one
+  S21Matrix control = source * other;
+  for (s21::SimdLevel level :
+       {s21::DetectedSimdLevel(), s21::SimdLevel::kSse2}) {
+    s21::SetSimdLevel(level);
+    s21::SetThreadCount(4);
+    S21FloatMatrix product = a * b;
+    s21::SetThreadCount(0);
+    for (int i = 0; i < 70; i++) {
+      for (int j = 0; j < 90; j++) {
+        EXPECT_NEAR(product(i, j), control(i, j), 1e-3);
+      }
+    }
+  }
+  s21::SetSimdLevel(s21::DetectedSimdLevel());
+  EXPECT_TRUE((a.TransposeView() * a).EqMatrix(a.Transpose() * a));
+
+  S21FloatMatrix square(3, 3);
+  float values[] = {2, 1, 0, 1, 3, 1, 0, 1, 4};
+  square.setGivenValues(values, 9);
+  EXPECT_FLOAT_EQ(square.Determinant(), 18);
+  S21FloatMatrix identity(3, 3);
+  for (int i = 0; i < 3; i++) identity(i, i) = 1;
+  EXPECT_TRUE((square * square.InverseMatrix()).EqMatrix(identity));
+  EXPECT_THROW(a + b, std::invalid_argument);
+}
+
+TEST(MatrixElementType, MatrixElementType_long_double_and_complex_test) {
+  S21LongDoubleMatrix hilbert(6, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) hilbert(i, j) = 1.0L / (i + j + 1);
+  }
+  S21LongDoubleMatrix identity(6, 6);
+  for (int i = 0; i < 6; i++) identity(i, i) = 1;
+  S21LongDoubleMatrix inverse = hilbert.InverseMatrix();
+  EXPECT_NEAR(static_cast<double>(inverse(0, 0)), 36, 1e-9);
+  EXPECT_TRUE((hilbert * inverse).EqMatrix(identity));
+  EXPECT_NEAR(static_cast<double>(hilbert.Determinant() * 186313420339200000),
+              1, 1e-9);
+
+  using Complex = std::complex<double>;
+  S21ComplexMatrix rotation(2, 2);
+  Complex values[] = {{0, 1}, {1, 0}, {2, 0}, {0, -1}};
+  rotation.setGivenValues(values, 4);
+  EXPECT_EQ(rotation.Determinant(), Complex(-1, 0));
+  S21ComplexMatrix unit(2, 2);
+  unit(0, 0) = unit(1, 1) = 1;
+  EXPECT_TRUE((rotation * rotation.InverseMatrix()).EqMatrix(unit));
+  EXPECT_TRUE((rotation * Complex(0, 1)).EqMatrix(rotation * 2.0 -
+                                                  rotation * Complex(2, -1)));
+
+  S21ComplexMatrix widened{S21Matrix(2, 3)};
+  EXPECT_EQ(widened.getCols(), 3);
+  S21ComplexMatrix big(40, 40);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 40; j++) big(i, j) = Complex(i == j ? 40 : 1, i - j);
+  }
+  S21ComplexMatrix bigUnit(40, 40);
+  for (int i = 0; i < 40; i++) bigUnit(i, i) = 1;
+  EXPECT_TRUE((big.InverseMatrix() * big).EqMatrix(bigUnit));
+  S21ComplexMatrix twice = big;
+  twice.TransposeInPlace();
+  EXPECT_TRUE(twice.Transpose().EqMatrix(big));
+}
+
+TEST(LuSolver, LuSolver_solve_test) {
+  const int n = 150;
+  S21Matrix a(n, n);
+  a.setValue();
+  for (int i = 0; i < n; i++) a(i, i) += n;
+  S21LuSolver lu(a);
+  EXPECT_EQ(lu.getSize(), n);
+  EXPECT_FALSE(lu.isSingular());
+  S21Matrix corner(a.Block(0, 0, 12, 12));
+  EXPECT_NEAR(S21LuSolver(corner).Determinant() / corner.Determinant(), 1,
+              1e-9);
+
+  std::vector<double> b(n);
+  for (int i = 0; i < n; i++) b[i] = i % 7 - 3;
+  std::vector<double> x = lu.Solve(b);
+  for (int i = 0; i < n; i++) {
+    double sum = 0;
+    for (int j = 0; j < n; j++) sum += a(i, j) * x[j];
+    EXPECT_NEAR(sum, b[i], 1e-9);
+  }
+
+  S21Matrix block(n, 5);
+  block.setValue();
+  S21Matrix solution = lu.Solve(block);
+  EXPECT_TRUE((a * solution).EqMatrix(block));
+  EXPECT_TRUE(a.Solve(block).EqMatrix(solution));
+  EXPECT_TRUE(lu.Solve(block.Col(2)).EqMatrix(solution.Col(2)));
+  lu.SolveInPlace(block);
+  EXPECT_TRUE(block.EqMatrix(solution));
+  EXPECT_TRUE(lu.InverseMatrix().EqMatrix(a.InverseMatrix()));
+
+  S21BasicLuSolver<float> single{S21FloatMatrix(a)};
+  std::vector<float> y = single.Solve(std::vector<float>(b.begin(), b.end()));
+  for (int i = 0; i < n; i++) EXPECT_NEAR(y[i], x[i], 1e-4);
+}
+
+TEST(LuSolver, LuSolver_errors_test) {
+  S21Matrix singular(3, 3);
+  double values[] = {1, 2, 3, 2, 4, 6, 1, 0, 1};
+  singular.setGivenValues(values, 9);
+  S21LuSolver lu(singular);
+  EXPECT_TRUE(lu.isSingular());
+  EXPECT_NEAR(lu.Determinant(), 0, 1e-12);
+  EXPECT_THROW(lu.Solve(std::vector<double>(3)), std::invalid_argument);
+  EXPECT_THROW(lu.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(singular.Solve(S21Matrix(3, 1)), std::invalid_argument);
+
+  S21Matrix identity(3, 3);
+  for (int i = 0; i < 3; i++) identity(i, i) = 1;
+  S21LuSolver regular(identity);
+  EXPECT_THROW(S21LuSolver(S21Matrix(2, 3)), std::invalid_argument);
+  EXPECT_THROW(regular.Solve(std::vector<double>(2)), std::invalid_argument);
+  EXPECT_THROW(regular.Solve(S21Matrix(4, 2)), std::invalid_argument);
+}
+
+TEST(LuSolver, LuSolver_badly_scaled_test) {
+  // regular matrices whose entries differ widely in scale are not singular
+  S21Matrix wide(2, 2);
+  wide(0, 0) = 1e20;
+  wide(1, 1) = 1;
+  S21Matrix spread(4, 4);
+  double values[] = {1e10, 5, 0, 0, 0, 1, 0, 0, 0, 0, 1e-7, 0, 0, 0, 0, 3};
+  spread.setGivenValues(values, 16);
+  S21Matrix diagonal(spread);
+  diagonal(0, 1) = 0;
+  const double determinants[] = {1e20, 3000, 3000};
+  int index = 0;
+  for (S21Matrix* m : {&wide, &spread, &diagonal}) {
+    const int n = m->getRows();
+    S21Matrix identity(n, n);
+    for (int i = 0; i < n; i++) identity(i, i) = 1;
+    S21LuSolver lu(*m);
+    EXPECT_FALSE(lu.isSingular());
+    EXPECT_NEAR(lu.Determinant() / determinants[index++], 1, 1e-12);
+    S21Matrix inverse = m->InverseMatrix();
+    EXPECT_TRUE((*m * inverse).EqMatrix(identity));
+    EXPECT_TRUE(lu.InverseMatrix().EqMatrix(inverse));
+    EXPECT_NO_THROW(m->CalcComplements());
+    EXPECT_TRUE(m->Solve(identity).EqMatrix(inverse));
+  }
+  EXPECT_FALSE(S21CholeskySolver(diagonal).isSingular());
+
+  S21MatrixBatch batch(2, 4, 4);
+  batch.Set(0, spread);
+  batch.Set(1, diagonal);
+  S21MatrixBatch inverses = batch.InverseMatrix();
+  EXPECT_TRUE(inverses.Get(0).EqMatrix(spread.InverseMatrix()));
+  EXPECT_TRUE(inverses.Get(1).EqMatrix(diagonal.InverseMatrix()));
+}
+
+TEST(RefinedSolver, RefinedSolver_refines_test) {
+  const int n = 150;
+  S21Matrix a(n, n);
+  a.setValue();
+  for (int i = 0; i < n; i++) a(i, i) += n;
+  S21RefinedSolver refined(a);
+  S21LuSolver lu(a);
+  std::vector<double> b(n);
+  for (int i = 0; i < n; i++) b[i] = i % 7 - 3;
+  std::vector<double> x = refined.Solve(b);
+  std::vector<double> expected = lu.Solve(b);
+  for (int i = 0; i < n; i++) EXPECT_NEAR(x[i], expected[i], 1e-13);
+  EXPECT_GT(refined.getIterations(), 0);
+  EXPECT_LT(refined.getIterations(), 5);
+  EXPECT_FALSE(refined.isFallback());
+
+  S21Matrix block(n, 4);
+  block.setValue();
+  EXPECT_TRUE(refined.Solve(block).EqMatrix(lu.Solve(block)));
+  EXPECT_FALSE(refined.isFallback());
+  EXPECT_THROW(refined.Solve(std::vector<double>(n + 1)),
+               std::invalid_argument);
+  EXPECT_THROW(S21RefinedSolver(S21Matrix(2, 3)), std::invalid_argument);
+}
+
+TEST(RefinedSolver, RefinedSolver_fallback_test) {
+  // the 10 x 10 Hilbert matrix is too ill-conditioned for float factors
+  const int n = 10;
+  S21Matrix hilbert(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) hilbert(i, j) = 1.0 / (i + j + 1);
+  }
+  S21RefinedSolver refined(hilbert);
+  S21Matrix b(n, 1);
+  for (int i = 0; i < n; i++) b(i, 0) = 1;
+  EXPECT_TRUE(refined.Solve(b).EqMatrix(hilbert.Solve(b)));
+  EXPECT_TRUE(refined.isFallback());
+
+  // elements past the float range skip refinement altogether
+  S21Matrix huge(2, 2);
+  double values[] = {1e39, 1e39, 1e39, -1e39};
+  huge.setGivenValues(values, 4);
+  S21RefinedSolver wide(huge);
+  S21Matrix::ConstMatrixView pair = b.Block(0, 0, 2, 1);
+  EXPECT_TRUE(wide.Solve(pair).EqMatrix(huge.Solve(pair)));
+  EXPECT_TRUE(wide.isFallback());
+  EXPECT_EQ(wide.getIterations(), 0);
+
+  S21Matrix singular(2, 2);
+  S21RefinedSolver none(singular);
+  EXPECT_THROW(none.Solve(std::vector<double>(2)), std::invalid_argument);
+}
+
+TEST(MatrixCache, MatrixCache_invalidation_test) {
+  const int n = 6;
+  S21Matrix a(n, n);
+  a.setValue();
+  for (int i = 0; i < n; i++) a(i, i) += n;
+  // a copy starts with no cache, so it always factors afresh
+  auto expectFresh = [](S21Matrix& m) {
+    S21Matrix copy(m);
+    EXPECT_NEAR(m.Determinant(), copy.Determinant(), 1e-9);
+    EXPECT_TRUE(m.InverseMatrix().EqMatrix(copy.InverseMatrix()));
+  };
+
+  double det = a.Determinant();
+  S21Matrix inverse = a.InverseMatrix();
+  EXPECT_DOUBLE_EQ(a.Determinant(), det);
+  EXPECT_TRUE(a.InverseMatrix().EqMatrix(inverse));
+  EXPECT_TRUE(a.CalcComplements().Transpose().EqMatrix(inverse * det));
+
+  a(0, 1) += 1;
+  expectFresh(a);
+  a.MulNumber(2);
+  expectFresh(a);
+  a.SumMatrix(a * 0.5);
+  expectFresh(a);
+  a.SubMatrix(a.Transpose() * 0.25);
+  expectFresh(a);
+  a.View()(2, 3) = -4;
+  expectFresh(a);
+  a.Block(1, 1, 2, 2)(0, 0) = 7;
+  expectFresh(a);
+  a.getData()[5] = 3;
+  expectFresh(a);
+  a.getMatrix()[4][4] = 9;
+  expectFresh(a);
+  a.TransposeInPlace();
+  expectFresh(a);
+  std::vector<double> values(n * n, 1.0);
+  for (int i = 0; i < n; i++) values[i * n + i] = 5;
+  a.setGivenValues(values.data(), n * n);
+  expectFresh(a);
+  a.setRows(n + 1);
+  EXPECT_THROW(a.Determinant(), std::invalid_argument);
+  a.setCols(n + 1);
+  a(n, n) = 2;
+  expectFresh(a);
+
+  // assignment and swap carry the elements, the cache must not outlive them
+  S21Matrix b(n + 1, n + 1);
+  for (int i = 0; i <= n; i++) b(i, i) = i + 1;
+  double bDet = b.Determinant();
+  a.Determinant();
+  a = b;
+  EXPECT_DOUBLE_EQ(a.Determinant(), bDet);
+  S21Matrix c(n + 1, n + 1);
+  for (int i = 0; i <= n; i++) c(i, i) = 2;
+  c.Determinant();
+  a.swap(c);
+  EXPECT_DOUBLE_EQ(a.Determinant(), 128);
+  EXPECT_DOUBLE_EQ(c.Determinant(), bDet);
+  S21Matrix moved(std::move(a));
+  EXPECT_DOUBLE_EQ(moved.Determinant(), 128);
+  moved = std::move(c);
+  EXPECT_DOUBLE_EQ(moved.Determinant(), bDet);
+  moved = moved * 2.0 + moved;
+  EXPECT_NEAR(moved.Determinant(), bDet * 2187, 1e-6);
+
+  S21Matrix singular(4, 4);
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  for (int i = 0; i < 4; i++) singular(i, i) = 1;
+  EXPECT_TRUE(singular.InverseMatrix().EqMatrix(singular));
+}
+
+TEST(CholeskySolver, CholeskySolver_solve_test) {
+  // a Gram matrix plus n on the diagonal, three panels wide
+  const int n = 150;
+  S21Matrix x(n, n);
+  x.setValue();
+  S21Matrix a = x.Transpose() * x * (1.0 / (n * n));
+  for (int i = 0; i < n; i++) a(i, i) += n;
+  S21CholeskySolver cholesky(a);
+  S21LuSolver lu(a);
+  EXPECT_EQ(cholesky.getSize(), n);
+  EXPECT_TRUE(cholesky.isPositiveDefinite());
+  EXPECT_FALSE(cholesky.isSingular());
+  S21Matrix l = cholesky.getFactor();
+  EXPECT_TRUE((l * l.Transpose()).EqMatrix(a));
+  EXPECT_EQ(l(0, 1), 0);
+  S21Matrix corner(a.Block(0, 0, 12, 12));
+  EXPECT_NEAR(S21CholeskySolver(corner).Determinant() / corner.Determinant(),
+              1, 1e-9);
+
+  std::vector<double> b(n);
+  for (int i = 0; i < n; i++) b[i] = i % 7 - 3;
+  std::vector<double> solution = cholesky.Solve(b);
+  std::vector<double> expected = lu.Solve(b);
+  for (int i = 0; i < n; i++) EXPECT_NEAR(solution[i], expected[i], 1e-12);
+  S21Matrix block(n, 5);
+  block.setValue();
+  S21Matrix blockSolution = cholesky.Solve(block);
+  EXPECT_TRUE(blockSolution.EqMatrix(lu.Solve(block)));
+  EXPECT_TRUE(cholesky.Solve(block.Col(3)).EqMatrix(blockSolution.Col(3)));
+  cholesky.SolveInPlace(block);
+  EXPECT_TRUE(block.EqMatrix(blockSolution));
+
+  // the matrix's own cache takes the Cholesky path for this input
+  S21Matrix inverse = cholesky.InverseMatrix();
+  EXPECT_TRUE(inverse.EqMatrix(lu.InverseMatrix()));
+  EXPECT_TRUE(a.InverseMatrix().EqMatrix(inverse));
+  EXPECT_TRUE(inverse.EqMatrix(inverse.Transpose()));
+  EXPECT_TRUE(corner.CalcComplements().Transpose().EqMatrix(
+      corner.InverseMatrix() * corner.Determinant()));
+
+  using Complex = std::complex<double>;
+  S21ComplexMatrix hermitian(70, 70);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 70; j++) {
+      hermitian(i, j) = Complex(i == j ? 140 : 1, (i - j) / 70.0);
+    }
+  }
+  S21BasicCholeskySolver<Complex> complexCholesky(hermitian);
+  EXPECT_TRUE(complexCholesky.isPositiveDefinite());
+  S21BasicLuSolver<Complex> complexLu(hermitian);
+  EXPECT_TRUE(
+      complexCholesky.InverseMatrix().EqMatrix(complexLu.InverseMatrix()));
+  EXPECT_LT(std::abs(complexCholesky.Determinant() / complexLu.Determinant() -
+                     1.0),
+            1e-9);
+}
+
+TEST(CholeskySolver, CholeskySolver_fallback_test) {
+  // symmetric but indefinite: the matrix falls back to LU
+  S21Matrix indefinite(4, 4);
+  double values[] = {1, 2, 0, 0, 2, 1, 0, 0, 0, 0, 4, 1, 0, 0, 1, 3};
+  indefinite.setGivenValues(values, 16);
+  S21CholeskySolver cholesky(indefinite);
+  EXPECT_FALSE(cholesky.isPositiveDefinite());
+  EXPECT_THROW(cholesky.Determinant(), std::invalid_argument);
+  EXPECT_THROW(cholesky.Solve(std::vector<double>(4)), std::invalid_argument);
+  EXPECT_THROW(cholesky.InverseMatrix(), std::invalid_argument);
+  S21LuSolver lu(indefinite);
+  EXPECT_NEAR(indefinite.Determinant(), -33, 1e-12);
+  EXPECT_TRUE(indefinite.InverseMatrix().EqMatrix(lu.InverseMatrix()));
+
+  // with detection off the same SPD matrix goes through LU
+  S21Matrix spd(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) spd(i, j) = i == j ? 5 : 1;
+  }
+  S21Matrix expected = S21CholeskySolver(spd).InverseMatrix();
+  s21::SetSpdDetection(false);
+  EXPECT_FALSE(s21::SpdDetection());
+  EXPECT_TRUE(spd.InverseMatrix().EqMatrix(expected));
+  EXPECT_NEAR(spd.Determinant(), 2304, 1e-9);
+  s21::SetSpdDetection(true);
+
+  S21Matrix singular(4, 4);
+  singular(0, 0) = singular(1, 1) = singular(2, 2) = 1;
+  S21CholeskySolver semidefinite(singular);
+  EXPECT_FALSE(semidefinite.isPositiveDefinite());
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(S21CholeskySolver(S21Matrix(2, 3)), std::invalid_argument);
+  S21CholeskySolver identity(S21Matrix(spd.Block(0, 0, 1, 1)));
+  EXPECT_THROW(identity.Solve(std::vector<double>(2)), std::invalid_argument);
+}
+
+TEST(ThreadPool, ThreadPool_runs_every_index_test) {
+  s21::ThreadPool pool(3);
+  EXPECT_EQ(pool.getThreads(), 3);
+  std::vector<int> hits(1000, 0);
+  for (int round = 0; round < 5; round++) {
+    pool.ParallelFor(static_cast<int>(hits.size()), [&](int i) {
+      hits[i]++;
+      pool.ParallelFor(2, [](int) {});
+    });
+  }
+  for (int value : hits) EXPECT_EQ(value, 5);
+
+  EXPECT_THROW(pool.ParallelFor(10,
+                                [](int i) {
+                                  if (i == 7) throw std::runtime_error("7");
+                                }),
+               std::runtime_error);
+}
+
 TEST(TransposeMatrix, TransposeMatrix_test) {
   S21Matrix matrix1(3, 2);
   S21Matrix control(2, 3);
@@ -290,6 +1426,40 @@ TEST(TransposeMatrix, TransposeMatrix_sq_test) {
   EXPECT_TRUE(result.EqMatrix(control));
 }
 
+TEST(TransposeMatrix, TransposeMatrix_large_test) {
+  S21Matrix matrix1(157, 301);
+  matrix1.setValue();
+  S21Matrix result = matrix1.Transpose();
+
+  ASSERT_EQ(result.getRows(), 301);
+  ASSERT_EQ(result.getCols(), 157);
+  for (int i = 0; i < matrix1.getRows(); i++) {
+    for (int j = 0; j < matrix1.getCols(); j++) {
+      EXPECT_EQ(result(j, i), matrix1(i, j));
+    }
+  }
+}
+
+TEST(TransposeMatrix, TransposeMatrix_in_place_test) {
+  S21Matrix square(70, 70);
+  square.setValue();
+  S21Matrix control = square.Transpose();
+  const double* buffer = square.getData();
+  square.TransposeInPlace();
+  EXPECT_EQ(square.getData(), buffer);
+  EXPECT_TRUE(square.EqMatrix(control));
+
+  S21Matrix rect(23, 58);
+  rect.setValue();
+  control = rect.Transpose();
+  buffer = rect.getData();
+  rect.TransposeInPlace();
+  EXPECT_EQ(rect.getData(), buffer);
+  EXPECT_EQ(rect.getRows(), 58);
+  EXPECT_EQ(rect.getCols(), 23);
+  EXPECT_TRUE(rect.EqMatrix(control));
+}
+
 TEST(Determinant, Determinant_1x1_test) {
   S21Matrix matrix1(1, 1);
   double values1[] = {5};
@@ -320,6 +1490,40 @@ TEST(Determinant, Determinant_usual_test) {
   EXPECT_EQ(control, check);
 }
 
+TEST(Determinant, Determinant_4x4_test) {
+  S21Matrix matrix1(4, 4);
+  double values1[] = {-1.0, 2.0,  7.0,  9.0,  1.0,  0.0, 0.0, 0.0,
+                      47.0, 13.0, 17.0, 21.0, 22.0, 7.0, 1.0, 3.0};
+  matrix1.setGivenValues(values1, sizeof(values1) / sizeof(values1[0]));
+
+  EXPECT_NEAR(matrix1.Determinant(), 138, 1e-9);
+}
+
+TEST(Determinant, Determinant_singular_test) {
+  S21Matrix matrix1(5, 5);
+  matrix1.setValue();
+  for (int j = 0; j < matrix1.getCols(); j++) {
+    matrix1(3, j) = 2 * matrix1(1, j);
+  }
+
+  EXPECT_NEAR(matrix1.Determinant(), 0, 1e-12);
+}
+
+TEST(Determinant, Determinant_large_test) {
+  // tridiagonal (-1, 2, -1) matrix of size n has determinant n + 1, the
+  // rows are reversed so the factorization has to pivot
+  const int n = 200;
+  S21Matrix matrix1(n, n);
+  for (int i = 0; i < n; i++) {
+    int row = n - 1 - i;
+    matrix1(row, i) = 2;
+    if (i > 0) matrix1(row, i - 1) = -1;
+    if (i < n - 1) matrix1(row, i + 1) = -1;
+  }
+
+  EXPECT_NEAR(matrix1.Determinant(), n + 1, 1e-8);
+}
+
 TEST(Determinant, Determinant_not_square_test) {
   S21Matrix matrix1(2, 3);
   double values1[] = {1, 2, 3, 4, 5, 6};
@@ -367,6 +1571,29 @@ TEST(InverseMatrix, InverseMatrix_test) {
   EXPECT_TRUE(check.EqMatrix(result));
 }
 
+TEST(InverseMatrix, InverseMatrix_large_test) {
+  const int n = 150;
+  S21Matrix matrix1(n, n);
+  matrix1.setValue();
+  for (int i = 0; i < n; i++) matrix1(i, (i * 7) % n) += n;
+  S21Matrix copy(matrix1);
+
+  S21Matrix result = matrix1.InverseMatrix();
+  EXPECT_TRUE(matrix1.EqMatrix(copy));
+
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; i++) identity(i, i) = 1;
+  EXPECT_TRUE((matrix1 * result).EqMatrix(identity));
+}
+
+TEST(InverseMatrix, InverseMatrix_singular_test) {
+  S21Matrix matrix1(3, 3);
+  double values1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  matrix1.setGivenValues(values1, sizeof(values1) / sizeof(values1[0]));
+
+  EXPECT_ANY_THROW(matrix1.InverseMatrix());
+}
+
 TEST(InverseMatrix, InverseMatrix_1x1_zero_test) {
   S21Matrix matrix1(1, 1);
   EXPECT_ANY_THROW(matrix1.InverseMatrix());
@@ -395,6 +1622,36 @@ TEST(CalcComplements, CalcComplements_test) {
   EXPECT_TRUE(result.EqMatrix(check));
 }
 
+TEST(CalcComplements, CalcComplements_singular_test) {
+  S21Matrix matrix1(3, 3);
+  double values1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  matrix1.setGivenValues(values1, sizeof(values1) / sizeof(values1[0]));
+  S21Matrix result = matrix1.CalcComplements();
+
+  S21Matrix check(3, 3);
+  double values2[] = {-3, 6, -3, 6, -12, 6, -3, 6, -3};
+  check.setGivenValues(values2, sizeof(values2) / sizeof(values2[0]));
+
+  EXPECT_TRUE(result.EqMatrix(check));
+}
+
+TEST(CalcComplements, CalcComplements_large_test) {
+  const int n = 120;
+  S21Matrix matrix1(n, n);
+  matrix1.setValue();
+  for (int i = 0; i < n; i++) matrix1(i, i) += 1;
+
+  // A * adj(A) = det(A) * I and adj(A) is the transposed cofactor matrix
+  S21Matrix result = matrix1.CalcComplements();
+  S21Matrix product = matrix1 * result.Transpose();
+  double det = matrix1.Determinant();
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      EXPECT_NEAR(product(i, j), i == j ? det : 0, 1e-9 * std::abs(det));
+    }
+  }
+}
+
 TEST(CalcComplements, CalcComplements_not_sq_test) {
   S21Matrix matrix1(4, 2);
   double values1[] = {-1.0, 2.0, 7.0, 9.0, 1.0, 0.0, 0.0, 0.0};
@@ -403,6 +1660,79 @@ TEST(CalcComplements, CalcComplements_not_sq_test) {
   EXPECT_ANY_THROW(matrix1.CalcComplements());
 }
 
+TEST(LazyExpression, LazyExpression_fused_test) {
+  S21Matrix a(4, 5), b(4, 5), c(4, 5);
+  a.setValue();
+  b.setValue();
+  c.setValue();
+  S21Matrix control = (a + b) * 2.0 - c;
+
+  S21Matrix result = (s21::Lazy(a) + b) * 2.0 - c;
+  EXPECT_TRUE(result.EqMatrix(control));
+
+  const double* buffer = result.getData();
+  result = c - 0.5 * (s21::Lazy(result) + c);
+  EXPECT_EQ(result.getData(), buffer);
+  control = (c - control) * 0.5;
+  EXPECT_TRUE(result.EqMatrix(control));
+
+  S21Matrix other(2, 2);
+  other = -s21::Lazy(a);
+  EXPECT_TRUE(other.EqMatrix(a * -1.0));
+}
+
+TEST(LazyExpression, LazyExpression_wrong_dims_test) {
+  S21Matrix a(4, 5), b(5, 4);
+  EXPECT_ANY_THROW(s21::Lazy(a) + b);
+  EXPECT_ANY_THROW(a - s21::Lazy(b) * 3.0);
+}
+
+TEST(FixedMatrix, FixedMatrix_compile_time_test) {
+  constexpr S21FixedMatrix<3, 3> matrix1{-9, 8, -7, -4, -5, -6, 7, -8, 9};
+  static_assert(matrix1.Determinant() == 320, "3x3 determinant");
+  constexpr S21FixedMatrix<2, 2> matrix2{4, 7, 2, 6};
+  static_assert(matrix2.InverseMatrix() ==
+                    S21FixedMatrix<2, 2>{0.6, -0.7, -0.2, 0.4},
+                "2x2 inverse");
+  constexpr S21FixedMatrix<2, 3> matrix3{1, 2, 3, 4, 5, 6};
+  static_assert((matrix3 * matrix3.Transpose())(1, 1) == 77, "product");
+  using Fixed2x2 = S21FixedMatrix<2, 2>;
+  EXPECT_ANY_THROW(Fixed2x2().InverseMatrix());
+  EXPECT_ANY_THROW(matrix3(2, 0));
+}
+
+TEST(FixedMatrix, FixedMatrix_matches_dynamic_test) {
+  S21Matrix dynamic4(4, 4);
+  double values1[] = {-1.0, 2.0,  7.0,  9.0,  1.0,  0.0, 0.0, 0.0,
+                      47.0, 13.0, 17.0, 21.0, 22.0, 7.0, 1.0, 3.0};
+  dynamic4.setGivenValues(values1, sizeof(values1) / sizeof(values1[0]));
+  S21FixedMatrix<4, 4> fixed4(dynamic4);
+  EXPECT_NEAR(fixed4.Determinant(), dynamic4.Determinant(), 1e-9);
+  EXPECT_TRUE(fixed4.CalcComplements().ToMatrix().EqMatrix(
+      S21Matrix(dynamic4).CalcComplements()));
+  EXPECT_TRUE(fixed4.InverseMatrix().ToMatrix().EqMatrix(
+      S21Matrix(dynamic4).InverseMatrix()));
+
+  S21Matrix dynamic5(5, 5);
+  dynamic5.setValue();
+  S21FixedMatrix<5, 5> fixed5(dynamic5);
+  EXPECT_NEAR(fixed5.Determinant(), dynamic5.Determinant(), 1e-12);
+  EXPECT_TRUE(fixed5.CalcComplements().ToMatrix().EqMatrix(
+      S21Matrix(dynamic5).CalcComplements()));
+  EXPECT_TRUE((fixed5 * fixed5.InverseMatrix()).ToMatrix().EqMatrix(
+      S21FixedMatrix<5, 5>{1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1,
+                           0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1}
+          .ToMatrix()));
+
+  S21Matrix dynamic3(3, 3);
+  dynamic3.setValue();
+  S21FixedMatrix<3, 3> fixed3(dynamic3);
+  EXPECT_TRUE(fixed3.InverseMatrix().ToMatrix().EqMatrix(
+      dynamic3.InverseMatrix()));
+  using Fixed3x3 = S21FixedMatrix<3, 3>;
+  EXPECT_ANY_THROW(Fixed3x3(S21Matrix(3, 4)));
+}
+
 TEST(PlusOperator, Plus_operator) {
   S21Matrix matrix1(2, 3);
   S21Matrix matrix2(2, 3);